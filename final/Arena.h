@@ -0,0 +1,87 @@
+#pragma once
+#include "common.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace compiler {
+
+// Bump allocator handing out memory from a few large blocks. Nothing is
+// freed one by one: everything allocated after a Mark is dropped at once
+// by rollback(), and all of it when the arena goes away. Destructors are
+// never run, so only trivially destructible objects belong here.
+class Arena
+{
+public:
+  struct Mark {
+    size_t block;
+    size_t offset;
+    bool operator<(const Mark& rhs) const {
+      return block < rhs.block || (block == rhs.block && offset < rhs.offset);
+    }
+  };
+
+  explicit Arena(size_t blockSize = 1 << 20)
+    : blockSize_(blockSize) { }
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+    size_t offset = (offset_ + align - 1) & ~(align - 1);
+    if (block_ >= blocks_.size() || offset + size > blocks_[block_].size) {
+      nextBlock(size);
+      offset = 0;
+    }
+    offset_ = offset + size;
+    return blocks_[block_].data.get() + offset;
+  }
+
+  template<typename T, typename... Args>
+  T* make(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  Mark mark() const {
+    return Mark { block_, offset_ };
+  }
+
+  // the blocks are kept for reuse
+  void rollback(const Mark& mark) {
+    CHECK(!(this->mark() < mark));
+    block_ = mark.block;
+    offset_ = mark.offset;
+  }
+
+  size_t numBlocks() const {
+    return blocks_.size();
+  }
+
+private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  void nextBlock(size_t size) {
+    // skip blocks left from before a rollback if they are too small
+    size_t next = blocks_.empty() ? 0 : block_ + 1;
+    while (next < blocks_.size() && blocks_[next].size < size) {
+      ++next;
+    }
+    if (next == blocks_.size()) {
+      size_t blockSize = size > blockSize_ ? size : blockSize_;
+      blocks_.push_back(Block { std::unique_ptr<char[]>(new char[blockSize]),
+                                blockSize });
+    }
+    block_ = next;
+  }
+
+  size_t blockSize_;
+  std::vector<Block> blocks_;
+  size_t block_ { 0 };
+  size_t offset_ { 0 };
+};
+
+}
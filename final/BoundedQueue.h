@@ -0,0 +1,65 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace compiler {
+
+// A queue between one producing and one consuming thread, holding at most
+// capacity items: the producer waits while it is full, the consumer while
+// it is empty. Either side may close it, which ends the waits of both.
+template<typename T>
+class BoundedQueue
+{
+public:
+  explicit BoundedQueue(size_t capacity)
+    : capacity_(capacity) { }
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // false, dropping the item, once the queue is closed
+  bool push(T&& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] {
+      return closed_ || items_.size() < capacity_;
+    });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  // false once the queue is closed and what was pushed before is taken
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return false;
+    }
+    item = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+  }
+
+private:
+  size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable notFull_;
+  std::condition_variable notEmpty_;
+  std::deque<T> items_;
+  bool closed_ { false };
+};
+
+}
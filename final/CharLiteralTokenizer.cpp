@@ -66,17 +66,17 @@ void CharLiteralTokenizer::handle(const PPToken& token,
 {
   // get encoding
   int start = 0; 
-  EFundamentalType type = getEncoding(token.data, start);
-  CHECK(token.data[start] == quote());
+  EFundamentalType type = getEncoding(token.data(), start);
+  CHECK(token.data()[start] == quote());
   ++start;
 
-  auto next = token.data.begin() + start;
+  auto next = token.data().begin() + start;
   // check empty character
   if (*next == quote()) {
     Throw("Empty character literal: {}", token.dataStrU8());
   }
 
-  int codePoint = Utf8Utils::getEscapedCodePoint(next, token.data.end());
+  int codePoint = Utf8Utils::getEscapedCodePoint(next, token.data().end());
 
   // check whether codePoint falls into expected range
 
@@ -99,7 +99,7 @@ void CharLiteralTokenizer::handle(const PPToken& token,
   }
 
   // Check whether there are trailing characters
-  CHECK(next != token.data.end());
+  CHECK(next != token.data().end());
   if (*next != quote()) {
     Throw("Multi-character literal not supported: {}", token.dataStrU8());
   }
@@ -6,6 +6,147 @@ namespace compiler {
 
 using namespace std;
 
+// the types a FundalmentalScalar holds, by their EFundamentalType
+#define FUNDALMENTAL_SCALAR_TYPES(X) \
+  X(FT_SIGNED_CHAR, signed char) \
+  X(FT_SHORT_INT, short) \
+  X(FT_INT, int) \
+  X(FT_LONG_INT, long) \
+  X(FT_LONG_LONG_INT, long long) \
+  X(FT_UNSIGNED_CHAR, unsigned char) \
+  X(FT_UNSIGNED_SHORT_INT, unsigned short) \
+  X(FT_UNSIGNED_INT, unsigned) \
+  X(FT_UNSIGNED_LONG_INT, unsigned long) \
+  X(FT_UNSIGNED_LONG_LONG_INT, unsigned long long) \
+  X(FT_WCHAR_T, wchar_t) \
+  X(FT_CHAR, char) \
+  X(FT_CHAR16_T, Char16_t) \
+  X(FT_CHAR32_T, Char32_t) \
+  X(FT_BOOL, bool) \
+  X(FT_FLOAT, float) \
+  X(FT_DOUBLE, double) \
+  X(FT_LONG_DOUBLE, long double)
+
+namespace {
+
+// f.apply<T>(scalar), T being the type of the scalar's value
+template<typename F>
+typename F::Result visit(const FundalmentalScalar& scalar, const F& f) {
+#define VISIT_CASE(ft, T) \
+  case ft: \
+    return f.template apply<T>(scalar);
+  switch (scalar.type) {
+    FUNDALMENTAL_SCALAR_TYPES(VISIT_CASE)
+    default:
+      MCHECK(false, format("Invalid fundalmental type: {}", scalar.type));
+      return typename F::Result();
+  }
+#undef VISIT_CASE
+}
+
+struct Convert {
+  typedef FundalmentalScalar Result;
+  EFundamentalType target;
+
+  template<typename T>
+  Result apply(const FundalmentalScalar& scalar) const {
+    T d = scalar.get<T>();
+#define CONVERT_CASE(ft, U) \
+    case ft: \
+      return FundalmentalScalar::of(ft, static_cast<U>(d));
+    switch (target) {
+      FUNDALMENTAL_SCALAR_TYPES(CONVERT_CASE)
+      default:
+        MCHECK(false, format("Invalid target type: {}", target));
+        return Result();
+    }
+#undef CONVERT_CASE
+  }
+};
+
+struct IsZero {
+  typedef bool Result;
+  template<typename T>
+  Result apply(const FundalmentalScalar& scalar) const {
+    return scalar.get<T>() == 0;
+  }
+};
+
+struct IsPositive {
+  typedef bool Result;
+  template<typename T>
+  Result apply(const FundalmentalScalar& scalar) const {
+    // Note: 
+    // [warning C4804: '>' : unsafe use of type 'bool' in operation]
+    // is supressed for VC++.
+    return scalar.get<T>() > 0;
+  }
+};
+
+struct IsSigned {
+  typedef bool Result;
+  template<typename T>
+  Result apply(const FundalmentalScalar&) const {
+    return is_signed<T>::value;
+  }
+};
+
+struct GetValue {
+  typedef uint64_t Result;
+  template<typename T>
+  Result apply(const FundalmentalScalar& scalar) const {
+    // TODO: examine this: [warning C4244: 'return' : conversion from 'const float' to 'uint64_t', possible loss of data]
+    return static_cast<uint64_t>(scalar.get<T>());
+  }
+};
+
+struct Negate {
+  typedef FundalmentalScalar Result;
+  template<typename T>
+  Result apply(const FundalmentalScalar& scalar) const {
+    // Note: supressed for VC++
+    // [warning C4800: 'int' : forcing value to bool 'true' or 'false' (performance warning)]
+    // [warning C4146: unary minus operator applied to unsigned type, result still unsigned]
+    return FundalmentalScalar::of(scalar.type,
+                                  static_cast<T>(-scalar.get<T>()));
+  }
+};
+
+}
+
+FundalmentalScalar FundalmentalScalar::to(EFundamentalType target) const {
+  return visit(*this, Convert { target });
+}
+
+bool FundalmentalScalar::isZero() const {
+  return visit(*this, IsZero());
+}
+
+bool FundalmentalScalar::isPositive() const {
+  return visit(*this, IsPositive());
+}
+
+bool FundalmentalScalar::isSigned() const {
+  return visit(*this, IsSigned());
+}
+
+uint64_t FundalmentalScalar::getValue() const {
+  return visit(*this, GetValue());
+}
+
+FundalmentalScalar FundalmentalScalar::negate() const {
+  return visit(*this, Negate());
+}
+
+SConstantValue FundalmentalValueBase::to(EFundamentalType target) const {
+  return make_shared<FundalmentalValueBase>(FundalmentalType::get(target),
+                                            scalar.to(target));
+}
+
+shared_ptr<FundalmentalValueBase> FundalmentalValueBase::negate() const {
+  return make_shared<FundalmentalValueBase>(type, scalar.negate());
+}
+
 bool MemberAddressValue::isConstant() const {
   return IdExpression(member).isConstant();
 }
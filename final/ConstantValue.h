@@ -2,6 +2,7 @@
 #include "Type.h"
 #include "TokenUtils.h"
 
+#include <cstring>
 #include <type_traits>
 
 // TODO: why in VC++ long is 32 bits and does it matter 
@@ -15,6 +16,51 @@
 
 namespace compiler {
 
+// A fundamental value held inline: its fundamental type and the value in
+// that type's own representation, in a payload big enough for long double.
+// Converting one and laying its bytes down allocate nothing.
+struct FundalmentalScalar {
+  template<typename T>
+  static FundalmentalScalar of(EFundamentalType ft, const T& d) {
+    static_assert(sizeof(T) <= sizeof(payload), "too big for a scalar");
+    FundalmentalScalar ret;
+    ret.type = ft;
+    memcpy(ret.payload, &d, sizeof(T));
+    return ret;
+  }
+
+  template<typename T>
+  static FundalmentalScalar of(const T& d) {
+    return of(FundamentalTypeOf<T>(), d);
+  }
+
+  // T must be the type of the value
+  template<typename T>
+  T get() const {
+    T d;
+    memcpy(&d, payload, sizeof(T));
+    return d;
+  }
+
+  FundalmentalScalar to(EFundamentalType target) const;
+  bool isZero() const;
+  bool isPositive() const;
+  bool isSigned() const;
+  uint64_t getValue() const;
+  FundalmentalScalar negate() const;
+
+  // the bytes it is laid down as
+  size_t size() const {
+    return FundalmentalType::get(type)->getTypeSize();
+  }
+  void appendTo(std::vector<char>& out) const {
+    out.insert(out.end(), payload, payload + size());
+  }
+
+  EFundamentalType type { FT_INT };
+  alignas(16) char payload[16] { };
+};
+
 template<typename T> struct FundalmentalValue;
 template<typename T> 
   using SFundalmentalValue = std::shared_ptr<FundalmentalValue<T>>;
@@ -37,135 +83,49 @@ struct ConstantValue {
     return nullptr;
   }
 
+  // appends the bytes the value is laid down as
   // TODO: make pure virtual
-  virtual std::vector<char> toBytes() const { return {}; }
+  virtual void appendBytes(std::vector<char>& out) const { }
+  std::vector<char> toBytes() const {
+    std::vector<char> ret;
+    appendBytes(ret);
+    return ret;
+  }
 
   SType type;
 };
 
 // TODO: provide operators so we can use them truely like directly in C/C++?
 struct FundalmentalValueBase : ConstantValue {
-  FundalmentalValueBase(SType t) : ConstantValue(t) { }
-  virtual bool isZero() const = 0;
-  virtual bool isPositive() const = 0;
-  virtual bool isSigned() const = 0;
-  virtual uint64_t getValue() const = 0;
-  virtual std::shared_ptr<FundalmentalValueBase> negate() const = 0;
+  FundalmentalValueBase(SType t, const FundalmentalScalar& s)
+    : ConstantValue(t), scalar(s) { }
+
+  SConstantValue to(EFundamentalType target) const override;
+  bool isZero() const { return scalar.isZero(); }
+  bool isPositive() const { return scalar.isPositive(); }
+  bool isSigned() const { return scalar.isSigned(); }
+  uint64_t getValue() const { return scalar.getValue(); }
+  std::shared_ptr<FundalmentalValueBase> negate() const;
+
+  void appendBytes(std::vector<char>& out) const override {
+    scalar.appendTo(out);
+  }
+
+  FundalmentalScalar scalar;
 };
 
+// only makes a FundalmentalValueBase from a T
 template<typename T>
 struct FundalmentalValue : FundalmentalValueBase {
   FundalmentalValue(SType type, const T& d)
-    : FundalmentalValueBase(type), data(d) {
+    : FundalmentalValueBase(
+        type,
+        FundalmentalScalar::of(
+          static_cast<const FundalmentalType&>(*type).getType(), d)) {
   }
   FundalmentalValue(EFundamentalType ft, const T& d)
-    : FundalmentalValue(std::make_shared<FundalmentalType>(ft), d) {
-  }
-
-  template<typename U>
-  std::shared_ptr<FundalmentalValue<U>>
-  convert(EFundamentalType target) const {
-    return std::make_shared<FundalmentalValue<U>>(
-             target, 
-             static_cast<U>(data));
-  }
-
-  SConstantValue to(EFundamentalType target) const override {
-    switch (target) {
-      case FT_SIGNED_CHAR:
-        return convert<signed char>(target);
-        break;
-      case FT_SHORT_INT:
-        return convert<short>(target);
-        break;
-      case FT_INT:
-        return convert<int>(target);
-        break;
-      case FT_LONG_INT:
-        return convert<long>(target);
-        break;
-      case FT_LONG_LONG_INT:
-        return convert<long long>(target);
-        break;
-      case FT_UNSIGNED_CHAR:
-        return convert<unsigned char>(target);
-        break;
-      case FT_UNSIGNED_SHORT_INT:
-        return convert<unsigned short>(target);
-        break;
-      case FT_UNSIGNED_INT:
-        return convert<unsigned>(target);
-        break;
-      case FT_UNSIGNED_LONG_INT:
-        return convert<unsigned long>(target);
-        break;
-      case FT_UNSIGNED_LONG_LONG_INT:
-        return convert<unsigned long long>(target);
-        break;
-      case FT_WCHAR_T:
-        return convert<wchar_t>(target);
-        break;
-      case FT_CHAR:
-        return convert<char>(target);
-        break;
-      case FT_CHAR16_T:
-        return convert<Char16_t>(target);
-        break;
-      case FT_CHAR32_T:
-        return convert<Char32_t>(target);
-        break;
-      case FT_BOOL:
-        return convert<bool>(target);
-        break;
-      case FT_FLOAT:
-        return convert<float>(target);
-        break;
-      case FT_DOUBLE:
-        return convert<double>(target);
-        break;
-      case FT_LONG_DOUBLE:
-        return convert<long double>(target);
-        break;
-      default:
-        MCHECK(false, format("Invalid target type: {}", target));
-        return nullptr;
-        break;
-    }
-  }
-
-  bool isZero() const override {
-    return data == 0;
-  }
-  bool isPositive() const override {
-    // Note: 
-    // [warning C4804: '>' : unsafe use of type 'bool' in operation]
-    // is supressed for VC++.
-    return data > 0;
+    : FundalmentalValue(FundalmentalType::get(ft), d) {
   }
-  bool isSigned() const override {
-    return std::is_signed<T>::value;
-  }
-  uint64_t getValue() const override {
-    // TODO: examine this: [warning C4244: 'return' : conversion from 'const float' to 'uint64_t', possible loss of data]
-    return static_cast<uint64_t>(data);
-  }
-  std::shared_ptr<FundalmentalValueBase> negate() const override {
-    // Note: supressed for VC++
-    // [warning C4800: 'int' : forcing value to bool 'true' or 'false' (performance warning)]
-    // [warning C4146: unary minus operator applied to unsigned type, result still unsigned]
-    return std::make_shared<FundalmentalValue<T>>(type, -data);
-  }
-
-  std::vector<char> toBytes() const override { 
-    std::vector<char> ret;
-    auto buf = reinterpret_cast<const char*>(&data);
-    for (size_t i = 0; i < type->getTypeSize(); ++i) {
-      ret.push_back(buf[i]);
-    }
-    return ret;
-  }
-
-  T data;
 };
 
 template<>
@@ -174,7 +134,7 @@ struct FundalmentalValue<std::nullptr_t> : ConstantValue {
     : ConstantValue(type) {
   }
   FundalmentalValue(EFundamentalType ft, std::nullptr_t d)
-    : FundalmentalValue(std::make_shared<FundalmentalType>(ft), d) {
+    : FundalmentalValue(FundalmentalType::get(ft), d) {
   }
 };
 
@@ -215,13 +175,10 @@ struct ArrayValue : ArrayValueBase {
       data(d) {
   }
 
-  std::vector<char> toBytes() const override { 
-    std::vector<char> ret;
+  void appendBytes(std::vector<char>& out) const override {
     for (auto& e : data) {
-      auto eb = createFundalmentalValue(e)->toBytes();
-      ret.insert(ret.end(), eb.begin(), eb.end());
+      FundalmentalScalar::of(e).appendTo(out);
     }
-    return ret; 
   }
 
   std::vector<T> data;
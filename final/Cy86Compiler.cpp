@@ -1,5 +1,6 @@
 #include "Cy86Compiler.h"
 #include "Cy86Parser.h"
+#include "TimeReport.h"
 
 namespace compiler {
 
@@ -52,7 +53,8 @@ const size_t kStartAddress = 0x400078;
 }
 
 std::pair<vector<char>, size_t>
-Cy86Compiler::compile(vector<UToken>&& tokens) {
+Cy86Compiler::compile(TokenBuffer&& tokens) {
+  TimeReport::Scope scope(TimeReport::Cy86Compiler);
   map<string, size_t> labelToAddress;
   vector<pair<const X86::Immediate*, size_t>> immToFix;
 
@@ -86,6 +88,7 @@ Cy86Compiler::compile(vector<UToken>&& tokens) {
   for (auto& kv : immToFix) {
     auto imm = kv.first;
     auto loc = kv.second;
+    TimeReport::count(TimeReport::Fixups);
     auto it = labelToAddress.find(imm->getLabel());
     if (it == labelToAddress.end()) {
       Throw("label {} undefined", imm->getLabel());
@@ -96,13 +99,11 @@ Cy86Compiler::compile(vector<UToken>&& tokens) {
     // apply constant offset
     value += imm->getConstant();
 
-    auto bytes = ConstantValue::createFundalmentalValue(
-                   static_cast<unsigned long>(value))
-                     ->toBytes();
+    auto bytes = FundalmentalScalar::of(static_cast<unsigned long>(value));
     // if the bytes is too long then the rightmost bytes are automatically
     // truncated as desired.
     for (int i = 0; i < imm->size() / 8; ++i) {
-      code[loc + i] = bytes[i];
+      code[loc + i] = bytes.payload[i];
     }
   }
 
@@ -1,6 +1,6 @@
 #pragma once 
 
-#include "Token.h"
+#include "TokenBuffer.h"
 
 #include <vector>
 #include <tuple>
@@ -10,7 +10,7 @@ namespace compiler {
 class Cy86Compiler {
  public:
    std::pair<std::vector<char>, size_t>
-   compile(std::vector<UToken>&& tokens);
+   compile(TokenBuffer&& tokens);
  private:
 };
 
@@ -22,7 +22,7 @@ SConstantValue negate(SConstantValue literal) {
 
 class Cy86ParserImp {
  public:
-  Cy86ParserImp(vector<UToken>&& tokens) : tokens_(move(tokens)) { }
+  Cy86ParserImp(TokenBuffer&& tokens) : tokens_(move(tokens)) { }
   vector<UCy86Instruction> parse() {
     return program();
   }
@@ -185,16 +185,16 @@ class Cy86ParserImp {
     return ret;
   }
 
-  const Token& cur() const {
-    return *tokens_[index_];
+  TokenRef cur() const {
+    return tokens_[index_];
   }
 
   void adv() {
     ++index_;
   }
 
-  const Token& getAdv() {
-    auto& r = cur();
+  TokenRef getAdv() {
+    auto r = cur();
     adv();
     return r;
   }
@@ -204,10 +204,7 @@ class Cy86ParserImp {
   }
 
   bool isSimple(ETokenType type) const {
-    if (!cur().isSimple()) {
-      return false;
-    }
-    return getSimpleTokenType(cur()) == type;
+    return tokens_.isSimple(index_, type);
   }
 
   bool isIdentifier() const {
@@ -236,7 +233,7 @@ class Cy86ParserImp {
     if (!isIdentifier()) {
       complainExpect("identifier", func);
     }
-    return getAdv().toSimpleStr();
+    return getAdv().source();
   }
 
   // TODO: should provide two forms. 
@@ -247,14 +244,14 @@ class Cy86ParserImp {
     if (!isLiteral()) {
       complainExpect("literal", func);
     }
-    return static_cast<const TokenLiteralBase&>(getAdv()).toConstantValue();
+    return getAdv().literal().toConstantValue();
   }
 
-  vector<UToken> tokens_;
+  TokenBuffer tokens_;
   size_t index_ { 0 };
 };
 
-vector<UCy86Instruction> Cy86Parser::parse(vector<UToken>&& tokens) {
+vector<UCy86Instruction> Cy86Parser::parse(TokenBuffer&& tokens) {
   return Cy86ParserImp(move(tokens)).parse();
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Token.h"
+#include "TokenBuffer.h"
 #include "Cy86Instruction.h"
 
 #include <vector>
@@ -9,7 +9,7 @@ namespace compiler {
 
 class Cy86Parser {
  public:
-   std::vector<Cy86::UCy86Instruction> parse(std::vector<UToken>&& tokens);
+   std::vector<Cy86::UCy86Instruction> parse(TokenBuffer&& tokens);
 };
 
 }
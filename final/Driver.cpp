@@ -1,29 +1,73 @@
 #include "Driver.h"
 #include "parsers/SemanticParser.h"
+#include "TimeReport.h"
 
 #include <exception>
+#include <thread>
 
 namespace compiler {
 
 using namespace std;
 
 void Driver::postTokenProcessor(const Token& token) {
-  if (token.isSimple()) {
-    if (static_cast<const TokenSimple&>(token).type == OP_RSHIFT) {
-      tokens_.push_back(make_unique<TokenSimple>(">", OP_RSHIFT_1));
-      tokens_.push_back(make_unique<TokenSimple>(">", OP_RSHIFT_2));
-      return;
+  if (pipe_) {
+    postToken(*pipe_, token);
+  } else {
+    postToken(tokens_, token);
+  }
+}
+
+void Driver::postSpelledToken(const SpelledToken& token) {
+  if (pipe_) {
+    postToken(*pipe_, token);
+  } else {
+    postToken(tokens_, token);
+  }
+}
+
+// The preprocessor runs ahead of the parser by at most what the pipe
+// holds. An error of its wins over what the parser made of the tokens
+// before it, as it does when one runs after the other.
+UTranslationUnit Driver::pipelined() {
+  TokenPipe pipe(tokens_);
+  pipe_ = &pipe;
+  tokens_.setMinDrop(parserOption_.minDroppedTokens);
+  thread preprocessing([this, &pipe] {
+    TimeReport::Thread timing;
+    try {
+      preprocessor_.process();
+      pipe.close();
+    } catch (...) {
+      pipe.fail(current_exception());
     }
-  } else if (token.isNewLine()) {
-    return;
+  });
+
+  UTranslationUnit translationUnit;
+  exception_ptr parseError;
+  try {
+    TimeReport::Scope scope(TimeReport::Parser);
+    translationUnit = SemanticParser(tokens_, parserOption_).process();
+  } catch (...) {
+    parseError = current_exception();
   }
-  // TODO: avoid this copying
-  tokens_.push_back(token.copy());
+  pipe.cancel();
+  preprocessing.join();
+  pipe_ = nullptr;
+
+  pipe.rethrow();
+  if (parseError) {
+    rethrow_exception(parseError);
+  }
+  return translationUnit;
 }
 
 UTranslationUnit Driver::process() {
   try {
+    if (parserOption_.isPipelined) {
+      return pipelined();
+    }
     preprocessor_.process();
+    TimeReport::Scope scope(TimeReport::Parser);
     return SemanticParser(tokens_, parserOption_).process();
   } catch (const exception& e) {
 		cerr << "ERROR: " << e.what() << endl;
@@ -4,6 +4,8 @@
 #include "parsers/ParserCommon.h"
 #include "BuildEnv.h"
 #include "Preprocessor.h"
+#include "TokenBuffer.h"
+#include "TokenPipe.h"
 #include "TranslationUnit.h"
 
 #include <functional>
@@ -18,6 +20,9 @@ class Driver {
     : preprocessor_(env, 
                     sourcePath, 
                     std::bind(&Driver::postTokenProcessor, 
+                              this,
+                              std::placeholders::_1),
+                    std::bind(&Driver::postSpelledToken, 
                               this,
                               std::placeholders::_1)),
       parserOption_(option) {
@@ -26,7 +31,11 @@ class Driver {
   const Namespace* getGlobalNamespace() const;
  private:
   void postTokenProcessor(const Token& token);
-  std::vector<UToken> tokens_;
+  void postSpelledToken(const SpelledToken& token);
+  UTranslationUnit pipelined();
+  TokenBuffer tokens_;
+  // where the tokens go instead while pipelined
+  TokenPipe* pipe_ = nullptr;
   Preprocessor preprocessor_;
   ParserOption parserOption_;
 };
@@ -5,6 +5,17 @@ namespace compiler {
 
 using namespace std;
 
+SLiteralExpression Expression::toConstant() const {
+  if (constant_) {
+    return constant_;
+  }
+  auto literal = fold();
+  if (isSettled()) {
+    constant_ = literal;
+  }
+  return literal;
+}
+
 SExpression Expression::assignableTo(SType target) const {
   auto expr = shared_from_this();
   if (target->isFundalmental()) { 
@@ -152,7 +163,16 @@ bool IdExpression::isConstant() const {
   }
 }
 
-SLiteralExpression IdExpression::toConstant() const {
+bool IdExpression::isSettled() const {
+  if (!isConstant()) {
+    return false;
+  }
+  // a reference folds to what its address folds to, which is not kept
+  auto var = entity->toVariable();
+  return !var->type->isReference() && var->initializer->expr->isSettled();
+}
+
+SLiteralExpression IdExpression::fold() const {
   CHECK(isConstant());
   CHECK(entity->isVariable());
   auto var = entity->toVariable();
@@ -201,7 +221,7 @@ bool FundalmentalTypeConversion::allowed(SFundalmentalType from,
   return true;
 }
 
-SLiteralExpression FundalmentalTypeConversion::toConstant() const {
+SLiteralExpression FundalmentalTypeConversion::fold() const {
   auto c = from->toConstant();
   auto value = c->value->to(type->toFundalmental()->getType());
   return make_shared<LiteralExpression>(move(value)); 
@@ -217,7 +237,7 @@ SBooleanConversion BooleanConversion::create(SExpression expr) {
   return nullptr;
 }
 
-SLiteralExpression BooleanConversion::toConstant() const {
+SLiteralExpression BooleanConversion::fold() const {
   SConstantValue value;
   auto literal = from->toConstant();
   if (auto al = dynamic_cast<LiteralAddressValue*>(literal->value.get())) {
@@ -232,7 +252,7 @@ SLiteralExpression BooleanConversion::toConstant() const {
   return make_shared<LiteralExpression>(value);
 }
 
-SLiteralExpression ArrayToPointerConversion::toConstant() const {
+SLiteralExpression ArrayToPointerConversion::fold() const {
   SConstantValue value;
   if (from->isConstant()) {
     value = make_shared<LiteralAddressValue>(
@@ -246,7 +266,7 @@ SLiteralExpression ArrayToPointerConversion::toConstant() const {
   return make_shared<LiteralExpression>(value);
 }
 
-SLiteralExpression FunctionToPointerConversion::toConstant() const {
+SLiteralExpression FunctionToPointerConversion::fold() const {
   CHECK(!from->isConstant());
   auto idExpr = dynamic_cast<const IdExpression*>(from.get());
   CHECK(idExpr);
@@ -397,7 +417,20 @@ bool ReferenceBinding::isConstant() const {
   }
 }
 
-SLiteralExpression ReferenceBinding::toConstant() const {
+bool ReferenceBinding::isSettled() const {
+  if (!isConstant()) {
+    return false;
+  }
+  auto id = dynamic_cast<const IdExpression*>(from.get());
+  if (!id || id->entity->isFunction()) {
+    return true;
+  }
+  // the address of a variable, or the one a reference is bound to
+  auto var = id->entity->toVariable();
+  return !var->type->isReference() || var->initializer->expr->isSettled();
+}
+
+SLiteralExpression ReferenceBinding::fold() const {
   auto id = dynamic_pointer_cast<const IdExpression>(from);
   if (id) {
     return make_shared<LiteralExpression>(id->getAddress());
@@ -37,13 +37,29 @@ struct Expression : std::enable_shared_from_this<Expression> {
   // If false then return nullptr
   SExpression assignableTo(SType target) const;
 
-  // Reduce this expression to a literal expression
-  virtual SLiteralExpression toConstant() const {
+  // Reduce this expression to a literal expression. The literal of a
+  // settled expression is kept on the node, so an initializer, array bound
+  // or static_assert condition asked for again is not evaluated again, and
+  // a conversion folds the kept literal of what it converts. Any other is
+  // folded each time it is asked for.
+  virtual SLiteralExpression toConstant() const;
+
+  // Whether this expression folds to the same literal from now on. It
+  // does not while what it refers to is not constant yet: an
+  // ArrayToPointerConversion, always constant itself, folds to the address
+  // of an array that is not defined yet, and to its value once it is.
+  virtual bool isSettled() const { return isConstant(); }
+
+  // the literal toConstant() returns
+  virtual SLiteralExpression fold() const {
     Throw("Expression must be a constant");
     return nullptr;
   }
 
   virtual void output(std::ostream& out) const = 0;
+
+ private:
+  mutable SLiteralExpression constant_;
 };
 
 inline std::ostream& operator<<(std::ostream& out, const Expression& e) {
@@ -88,7 +104,8 @@ struct IdExpression : Expression {
 
   SType getType() const override;
   bool isConstant() const override;
-  SLiteralExpression toConstant() const override;
+  bool isSettled() const override;
+  SLiteralExpression fold() const override;
   SAddressValue getAddress() const;
 
   void output(std::ostream& out) const override;
@@ -108,6 +125,9 @@ struct ConversionExpression : Expression {
   bool isConstant() const override {
     return from->isConstant();
   }
+  bool isSettled() const override {
+    return isConstant() && from->isSettled();
+  }
 
   SType fromType() const { return from->getType(); }
 
@@ -129,7 +149,7 @@ struct LValueToRValueConversion : ConversionExpression {
     type->setCvQualifier(CvQualifier::None);    
   }
   
-  SLiteralExpression toConstant() const override {
+  SLiteralExpression fold() const override {
     return from->toConstant();
   }
 };
@@ -147,7 +167,7 @@ struct ArrayToPointerConversion : ConversionExpression {
     return true;
   }
 
-  SLiteralExpression toConstant() const override;
+  SLiteralExpression fold() const override;
 };
 
 struct FunctionToPointerConversion : ConversionExpression {
@@ -162,7 +182,7 @@ struct FunctionToPointerConversion : ConversionExpression {
     return true;
   }
 
-  SLiteralExpression toConstant() const override;
+  SLiteralExpression fold() const override;
 };
 
 struct FundalmentalTypeConversion : ConversionExpression {
@@ -178,7 +198,7 @@ struct FundalmentalTypeConversion : ConversionExpression {
 
   static bool allowed(SFundalmentalType from, SFundalmentalType to);
 
-  SLiteralExpression toConstant() const override;
+  SLiteralExpression fold() const override;
 };
 
 // Only covers the conversions not covered by FundalmentalTypeConversion
@@ -189,7 +209,7 @@ struct BooleanConversion : ConversionExpression {
   BooleanConversion(SExpression e)
     : ConversionExpression("BooleanConversion", e) {
   }
-  SLiteralExpression toConstant() const override;
+  SLiteralExpression fold() const override;
 };
 
 struct PointerConversion : ConversionExpression {
@@ -206,7 +226,7 @@ struct PointerConversion : ConversionExpression {
     return true;
   }
 
-  SLiteralExpression toConstant() const override {
+  SLiteralExpression fold() const override {
     return std::make_shared<LiteralExpression>(
              make_unique<LiteralAddressValue>(getType(), nullptr));
   }
@@ -226,7 +246,7 @@ struct QualificationConversion : ConversionExpression {
 
   static bool allowed(SPointerType from, SPointerType to);
 
-  SLiteralExpression toConstant() const override {
+  SLiteralExpression fold() const override {
     return from->toConstant();
   }
 };
@@ -245,7 +265,8 @@ struct ReferenceBinding : Expression {
   SType getType() const override { return refType->getDepended(); }
   bool isConstant() const override;
   bool isConstant(const IdExpression* id) const;
-  SLiteralExpression toConstant() const override;
+  bool isSettled() const override;
+  SLiteralExpression fold() const override;
   void output(std::ostream& out) const override;
 
   SExpression from;
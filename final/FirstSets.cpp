@@ -0,0 +1,141 @@
+#include "FirstSets.h"
+#include <cctype>
+#include <sstream>
+
+namespace compiler {
+
+using namespace std;
+
+namespace {
+
+string trim(const string& s)
+{
+  size_t begin = s.find_first_not_of(" \t\n");
+  if (begin == string::npos) {
+    return "";
+  }
+  size_t end = s.find_last_not_of(" \t\n");
+  return s.substr(begin, end - begin + 1);
+}
+
+// simpleTypeSpecifier to "simple type specifier"
+string describe(const string& name)
+{
+  string s;
+  for (char c : name) {
+    if (isupper(c)) {
+      s += ' ';
+      s += static_cast<char>(tolower(c));
+    } else {
+      s += c;
+    }
+  }
+  return s;
+}
+
+}
+
+FirstSets::FirstSets(const vector<const char*>& grammar)
+{
+  vector<pair<string, string>> lines;
+  for (const char* line : grammar) {
+    string s(line);
+    size_t colon = s.find(':');
+    MCHECK(colon != string::npos, format("bad grammar line: {}", s));
+    string name = trim(s.substr(0, colon));
+    MCHECK(ruleIds_.count(name) == 0, format("rule {} is repeated", name));
+    ruleIds_[name] = static_cast<int>(lines.size());
+    descriptions_.push_back(describe(name));
+    lines.emplace_back(name, s.substr(colon + 1));
+  }
+
+  rules_.resize(lines.size());
+  for (size_t i = 0; i < lines.size(); ++i) {
+    istringstream alternatives(lines[i].second);
+    for (string alternative; getline(alternatives, alternative, '|'); ) {
+      istringstream symbols(alternative);
+      Alternative alt;
+      for (string symbol; symbols >> symbol; ) {
+        alt.push_back(parseSymbol(symbol));
+      }
+      MCHECK(!alt.empty(), format("empty alternative in {}", lines[i].first));
+      rules_[i].push_back(move(alt));
+    }
+  }
+
+  first_.resize(rules_.size());
+  nullable_.resize(rules_.size());
+  for (bool changed = true; changed; ) {
+    changed = false;
+    for (size_t i = 0; i < rules_.size(); ++i) {
+      Set first = first_[i];
+      bool nullable = nullable_[i];
+      for (auto& alt : rules_[i]) {
+        bool empty = true;
+        for (auto& symbol : alt) {
+          if (symbol.rule >= 0) {
+            first |= first_[symbol.rule];
+          } else {
+            first |= symbol.tokens;
+          }
+          if (!symbol.optional &&
+              (symbol.rule < 0 || !nullable_[symbol.rule])) {
+            empty = false;
+            break;
+          }
+        }
+        nullable = nullable || empty;
+      }
+      if (first != first_[i] || nullable != nullable_[i]) {
+        first_[i] = first;
+        nullable_[i] = nullable;
+        changed = true;
+      }
+    }
+  }
+}
+
+int FirstSets::rule(const string& name) const
+{
+  auto it = ruleIds_.find(name);
+  return it == ruleIds_.end() ? -1 : it->second;
+}
+
+FirstSets::Symbol FirstSets::parseSymbol(string s) const
+{
+  Symbol symbol { -1, Set(), false };
+  if (s.back() == '?' || s.back() == '*') {
+    symbol.optional = true;
+    s.pop_back();
+  }
+  auto itRule = ruleIds_.find(s);
+  if (itRule != ruleIds_.end()) {
+    symbol.rule = itRule->second;
+    return symbol;
+  }
+  auto other = [](TokenType type) {
+    return OP_LT_TEMPLATE + 1 + static_cast<int>(type);
+  };
+  if (s == "identifier") {
+    symbol.tokens.set(other(TokenType::Identifier));
+  } else if (s == "literal") {
+    symbol.tokens.set(other(TokenType::Literal));
+  } else if (s == "eof") {
+    symbol.tokens.set(other(TokenType::Eof));
+  } else if (s == "any") {
+    symbol.tokens.set();
+  } else {
+    bool found = false;
+    for (auto& e : TokenTypeToStringMap) {
+      if (e.second == s) {
+        symbol.tokens.set(e.first);
+        found = true;
+        break;
+      }
+    }
+    MCHECK(found, format("unknown grammar symbol: {}", s));
+  }
+  return symbol;
+}
+
+}
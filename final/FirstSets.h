@@ -0,0 +1,63 @@
+#pragma once
+#include "TokenBuffer.h"
+#include <bitset>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler {
+
+// FIRST sets of a grammar written as lines of
+//   rule: symbol symbol ... | symbol ... | ...
+// A symbol is a rule, a simple token type as named in TokenUtils.h, or one
+// of identifier, literal, eof and any. A trailing ? or * makes it optional. An
+// alternative only needs to be spelled out up to its first required symbol.
+class FirstSets
+{
+public:
+  // simple token types followed by the other TokenTypes
+  static const int NumTokenClasses =
+    OP_LT_TEMPLATE + 1 + static_cast<int>(TokenType::Eof) + 1;
+  typedef std::bitset<NumTokenClasses> Set;
+
+  explicit FirstSets(const std::vector<const char*>& grammar);
+
+  // -1 if there is no such rule
+  int rule(const std::string& name) const;
+  // false only if the rule can neither start with token nor match nothing
+  bool mayStart(int rule, TokenRef token) const {
+    return nullable_[rule] || first_[rule][tokenClass(token)];
+  }
+
+  // what a diagnostic calls the rule: its name in words, so that
+  // simpleTypeSpecifier is "simple type specifier"
+  const char* description(int rule) const {
+    return descriptions_[rule].c_str();
+  }
+
+  static int tokenClass(TokenRef token) {
+    if (token.isSimple()) {
+      return token.simpleType();
+    }
+    return OP_LT_TEMPLATE + 1 + static_cast<int>(token.getType());
+  }
+
+private:
+  struct Symbol {
+    // a rule id, or -1 for the token classes in tokens
+    int rule;
+    Set tokens;
+    bool optional;
+  };
+  typedef std::vector<Symbol> Alternative;
+
+  Symbol parseSymbol(std::string s) const;
+
+  std::unordered_map<std::string, int> ruleIds_;
+  std::vector<std::vector<Alternative>> rules_;
+  std::vector<Set> first_;
+  std::vector<bool> nullable_;
+  std::vector<std::string> descriptions_;
+};
+
+}
@@ -96,16 +96,16 @@ bool FloatLiteralTokenizer::handleUserDefined(
 bool FloatLiteralTokenizer::handleFloat(const PPToken& token)
 {
   EFundamentalType type = FT_DOUBLE;
-  It end = token.data.end();
-  int suffix = token.data.back();
+  It end = token.data().end();
+  int suffix = token.data().back();
   if (suffix == 'F' || suffix == 'f') {
     type = FT_FLOAT;
-    end = token.data.end() - 1;
+    end = token.data().end() - 1;
   } else if (suffix == 'L' || suffix == 'l') {
     type = FT_LONG_DOUBLE;
-    end = token.data.end() - 1;
+    end = token.data().end() - 1;
   }
-  if (!floatLiteral(token.data.begin(), end)) {
+  if (!floatLiteral(token.data().begin(), end)) {
     return false;
   }
   
@@ -125,19 +125,19 @@ bool FloatLiteralTokenizer::handleFloat(const PPToken& token)
 bool FloatLiteralTokenizer::put(const PPToken& token)
 {
   // to simplify parsing, require ud-suffix to start with '_'
-  auto it = find(token.data.begin(), token.data.end(), '_');
-  if (it != token.data.end()) {
+  auto it = find(token.data().begin(), token.data().end(), '_');
+  if (it != token.data().end()) {
     // make sure the suffix does not contain '+' or '-'
-    if (find(it, token.data.end(), '+') != token.data.end() ||
-        find(it, token.data.end(), '-') != token.data.end()) {
+    if (find(it, token.data().end(), '+') != token.data().end() ||
+        find(it, token.data().end(), '-') != token.data().end()) {
       cerr << format("bad ud_suffix for {}", token.dataStrU8()) << endl;
       return false;
     }
     return handleUserDefined(
               token,
-              token.data.begin(), 
+              token.data().begin(), 
               it,
-              Utf8Encoder::encode(vector<int>(it, token.data.end())));
+              Utf8Encoder::encode(vector<int>(it, token.data().end())));
   } else {
     return handleFloat(token);
   }
@@ -0,0 +1,82 @@
+#include "HideSet.h"
+#include "common.h"
+#include <algorithm>
+#include <iterator>
+
+namespace compiler {
+
+using namespace std;
+
+bool HideSet::contains(int id) const
+{
+  return node_ && binary_search(node_->ids.begin(), node_->ids.end(), id);
+}
+
+namespace {
+
+size_t hashIds(const vector<int>& ids)
+{
+  // FNV-1a
+  size_t h = 14695981039346656037ull;
+  for (int id : ids) {
+    h = (h ^ static_cast<unsigned>(id)) * 1099511628211ull;
+  }
+  return h;
+}
+
+}
+
+const HideSet::Node* HideSetPool::get(vector<int>&& ids)
+{
+  size_t h = hashIds(ids);
+  auto range = nodes_.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->ids == ids) {
+      return it->second.get();
+    }
+  }
+  auto node = make_unique<HideSet::Node>(move(ids));
+  auto it = nodes_.insert(make_pair(h, move(node)));
+  return it->second.get();
+}
+
+HideSet HideSetPool::add(HideSet s, int id)
+{
+  if (s.contains(id)) {
+    return s;
+  }
+  if (!s.node_) {
+    return HideSet(get({id}));
+  }
+
+  auto& cached = s.node_->added[id];
+  if (!cached) {
+    vector<int> ids(s.node_->ids);
+    ids.insert(upper_bound(ids.begin(), ids.end(), id), id);
+    cached = get(move(ids));
+  }
+  return HideSet(cached);
+}
+
+HideSet HideSetPool::unite(HideSet a, HideSet b)
+{
+  if (!a.node_ || a == b) {
+    return b;
+  }
+  if (!b.node_) {
+    return a;
+  }
+
+  auto& cached = a.node_->united[b.node_];
+  if (!cached) {
+    vector<int> ids;
+    ids.reserve(a.node_->ids.size() + b.node_->ids.size());
+    set_union(a.node_->ids.begin(), a.node_->ids.end(),
+              b.node_->ids.begin(), b.node_->ids.end(),
+              back_inserter(ids));
+    cached = get(move(ids));
+  }
+  return HideSet(cached);
+}
+
+}
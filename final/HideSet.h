@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <unordered_map>
+
+namespace compiler {
+
+class HideSetPool;
+
+// The set of macros a token was produced by (see C++ standard 16.3.4).
+// Macros are named by the spelling ids of their names (see Spellings), and
+// each distinct set is stored exactly once in a HideSetPool, so a HideSet is
+// a single pointer and two HideSets are equal iff they point to the same
+// node.
+class HideSet {
+public:
+  HideSet() { }
+  bool empty() const { return node_ == nullptr; }
+  bool contains(int id) const;
+  bool operator==(HideSet rhs) const { return node_ == rhs.node_; }
+  bool operator!=(HideSet rhs) const { return node_ != rhs.node_; }
+private:
+  friend class HideSetPool;
+  struct Node {
+    explicit Node(std::vector<int>&& _ids) : ids(std::move(_ids)) { }
+    // sorted
+    std::vector<int> ids;
+    // memoized results of HideSetPool::add and HideSetPool::unite
+    mutable std::unordered_map<int, const Node*> added;
+    mutable std::unordered_map<const Node*, const Node*> united;
+  };
+  explicit HideSet(const Node* node) : node_(node) { }
+
+  // nullptr is the empty set
+  const Node* node_ { nullptr };
+};
+
+class HideSetPool {
+public:
+  HideSet add(HideSet s, int id);
+  HideSet unite(HideSet a, HideSet b);
+private:
+  const HideSet::Node* get(std::vector<int>&& ids);
+
+  // keyed by the hash of the node's ids, which live only in the node
+  std::unordered_multimap<size_t, std::unique_ptr<HideSet::Node>> nodes_;
+};
+
+}
@@ -230,9 +230,9 @@ bool IntegerLiteralTokenizer::handleInteger(const PPToken& token)
   bool _long = false;
   bool _longlong = false;
 
-  auto it = token.data.end() - 1;
+  auto it = token.data().end() - 1;
   int count[4] { 0 }; // l, L, u, U
-  while (it >= token.data.end() - min(static_cast<int>(token.data.size()), 3)) {
+  while (it >= token.data().end() - min(static_cast<int>(token.data().size()), 3)) {
     if (*it == 'l') {
       ++count[0];
     } else if (*it == 'L') {
@@ -247,7 +247,7 @@ bool IntegerLiteralTokenizer::handleInteger(const PPToken& token)
     --it;
   } 
   ++it;
-  int n = token.data.end() - it;
+  int n = token.data().end() - it;
   try {
     if (count[0] && count[1]) {
       Throw("Integer suffix cannot have both `l' and `L`");
@@ -283,7 +283,7 @@ bool IntegerLiteralTokenizer::handleInteger(const PPToken& token)
 
   uint64_t r{0};
   bool octOrHex{false};
-  if (!parseInteger(token.data.begin(), it, octOrHex, r)) {
+  if (!parseInteger(token.data().begin(), it, octOrHex, r)) {
     return false;
   }
 
@@ -341,19 +341,19 @@ bool IntegerLiteralTokenizer::handleInteger(const PPToken& token)
 bool IntegerLiteralTokenizer::put(const PPToken& token)
 {
   // to simplify parsing, require ud-suffix to start with '_'
-  auto it = find(token.data.begin(), token.data.end(), '_');
-  if (it != token.data.end()) {
+  auto it = find(token.data().begin(), token.data().end(), '_');
+  if (it != token.data().end()) {
     // make sure the suffix does not contain '+' or '-'
-    if (find(it, token.data.end(), '+') != token.data.end() ||
-        find(it, token.data.end(), '-') != token.data.end()) {
+    if (find(it, token.data().end(), '+') != token.data().end() ||
+        find(it, token.data().end(), '-') != token.data().end()) {
       cerr << format("bad ud_suffix for {}", token.dataStrU8()) << endl;
       return false;
     }
     return handleUserDefined(
               token,
-              token.data.begin(), 
+              token.data().begin(), 
               it,
-              Utf8Encoder::encode(vector<int>(it, token.data.end())));
+              Utf8Encoder::encode(vector<int>(it, token.data().end())));
   } else {
     return handleInteger(token);
   }
@@ -1,4 +1,5 @@
 #include "Linker.h"
+#include "TimeReport.h"
 
 #include <tuple>
 
@@ -196,10 +197,16 @@ void Linker::checkOdr() {
 
 
 vector<char> Linker::getAddress(size_t addr) {
-  return ConstantValue::createFundalmentalValue(
-           FT_UNSIGNED_LONG_INT,
-           static_cast<unsigned long>(addr))
-         ->toBytes();
+  vector<char> ret;
+  FundalmentalScalar::of(FT_UNSIGNED_LONG_INT,
+                         static_cast<unsigned long>(addr)).appendTo(ret);
+  return ret;
+}
+
+const vector<char>& Linker::bytesOf(const ConstantValue& value) {
+  bytes_.clear();
+  value.appendBytes(bytes_);
+  return bytes_;
 }
 
 bool Linker::getAddress(SMember m, vector<char>& ret) {
@@ -215,6 +222,7 @@ bool Linker::getAddress(SMember m, vector<char>& ret) {
 
 void Linker::update(Address target, const vector<char>& bytes) {
   CHECK(target.second - target.first == bytes.size());
+  TimeReport::count(TimeReport::Fixups);
   for (size_t i = 0; i < bytes.size(); ++i) {
     image_[target.first + i] = bytes[i];
   }
@@ -251,7 +259,7 @@ Address Linker::genFundalmental(SVariableMember m) {
   auto& initializer = *m->initializer;
   if (!initializer.isDefault() && initializer.expr->isConstant()) {
     auto literal = initializer.expr->toConstant();
-    auto bytes = literal->value->toBytes();
+    auto& bytes = bytesOf(*literal->value);
     return genEntry(bytes.data(), bytes.size(), m->type->getTypeAlign());
   } else {
     return genZero(m->type->getTypeSize(), m->type->getTypeAlign());
@@ -268,7 +276,7 @@ Address Linker::genArray(SVariableMember m) {
     auto literalExpr = initializer.expr->toConstant();
     addLiteral(literalExpr->value.get());
 
-    auto bytes = literalExpr->value->toBytes();
+    auto& bytes = bytesOf(*literalExpr->value);
     auto addr1 = genEntry(bytes.data(), bytes.size(), m->type->getTypeAlign());
     auto addr2 = genZero(m->type->getTypeSize() - bytes.size(), 
                          m->type->getTypeAlign());
@@ -385,7 +393,7 @@ void Linker::generateImage() {
   }
 
   for (auto literal : literals_) {
-    auto bytes = literal->toBytes();
+    auto& bytes = bytesOf(*literal);
     auto addr = genEntry(bytes.data(), 
                          bytes.size(), 
                          literal->type->getTypeAlign());
@@ -396,6 +404,7 @@ void Linker::generateImage() {
 }
 
 auto Linker::process() -> Image {
+  TimeReport::Scope scope(TimeReport::Linker);
   checkOdr();
   generateImage();
   return image_;
@@ -13,6 +13,8 @@ class Linker {
     bool valid() const { return first < second; }
   };
 
+  // for the units to be added, whose types then compare by pointer
+  const STypeContext& getTypeContext() const { return typeContext_; }
   void addTranslationUnit(UTranslationUnit&& unit);
   Image process();
  private:
@@ -41,14 +43,18 @@ class Linker {
 
   bool getAddress(SMember, std::vector<char>& ret);
   std::vector<char> getAddress(size_t addr);
+  // in bytes_, until the next call
+  const std::vector<char>& bytesOf(const ConstantValue& value);
 
   // addr - address of the pointer/reference we need to update later
   void addLiteral(const ConstantValue* literal, Address addr = Address{});
   void addTemporary(SVariableMember m, Address addr);
 
+  STypeContext typeContext_ { std::make_shared<TypeContext>() };
   std::vector<UTranslationUnit> units_;
   std::multimap<std::string, SMember> members_;
   Image image_;
+  std::vector<char> bytes_;
   std::map<SMember, Address> memberAddress_;
   // addresses that need to be updated after the member is laid down
   std::map<SMember, std::vector<Address>> addressToMember_;
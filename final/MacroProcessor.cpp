@@ -1,12 +1,15 @@
 #include "MacroProcessor.h"
 #include "PPDirectiveUtil.h"
 #include "preprocessing_token/PPTokenizer.h"
+#include "preprocessing_token/PPTokenRelexer.h"
 #include "PredefinedMacros.h"
+#include "TimeReport.h"
 #include <string>
 #include <memory>
 #include <sstream>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 
 namespace compiler {
 
@@ -37,7 +40,19 @@ PPToken mergeToken(const PPToken& a, const PPToken& b)
 {
   // cout << format("merge {} with {}\n", a.dataStrU8(), b.dataStrU8());
 
-  // run a "mini" inline pp-tokenizer
+  vector<int> data(a.data());
+  data.insert(data.end(), b.data().begin(), b.data().end());
+
+  // the common cases (identifiers, pp-numbers and operators) are classified
+  // directly
+  PPTokenType type;
+  if (PPTokenRelexer::classify(data, &type)) {
+    PPToken merged(type, data);
+    merged.location = a.location;
+    return merged;
+  }
+
+  // otherwise run a "mini" inline pp-tokenizer
   size_t tokenCount = 0;
   PPToken merged;
   auto receiver = [&](const PPToken& token) {
@@ -45,7 +60,7 @@ PPToken mergeToken(const PPToken& a, const PPToken& b)
         token.type != PPTokenType::NewLine) {
       // cout << "received token " << token.dataStrU8() << endl;
       ++tokenCount;
-      merged = PPToken(token, a.file, a.line);
+      merged = PPToken(token, a.location);
     }
   };
 
@@ -93,7 +108,7 @@ PPToken getLiteral(vector<MacroProcessor::TextToken>&& tokens) {
       prevSpace = true;
     } else {
       prevSpace = false;
-      for (int x : t.data) {
+      for (int x : t.data()) {
         if (t.isQuotedOrUserDefinedLiteral() &&
             (x == '\\' || x == '"')) {
           data.push_back('\\');
@@ -108,33 +123,6 @@ PPToken getLiteral(vector<MacroProcessor::TextToken>&& tokens) {
   return PPToken(PPTokenType::StringLiteral, data);
 }
 
-bool included(const vector<string>& names, const PPToken& token) {
-  if (!token.isId()) {
-    return false;
-  }
-  return find(names.begin(), names.end(), token.dataStrU8()) != names.end();
-}
-
-vector<string> add(const vector<string>& names, const string& name) {
-  vector<string> r(names);
-  r.push_back(name);
-  return r;
-}
-
-vector<string> add(const vector<string>& a, const vector<string>& b) {
-  vector<string> r(a);
-  r.insert(r.end(), b.begin(), b.end());
-  return r;
-}
-
-}
-
-bool MacroProcessor::TextToken::canExpand() {
-  // cout << format("canExpand: {}=>{}\n", parentMacros, token.dataStrU8());
-  if (!expand) {
-    return false;
-  }
-  return expand = !included(parentMacros, token);
 }
 
 string MacroProcessor::Repl::toStr() const {
@@ -188,20 +176,20 @@ string MacroProcessor::Macro::toStr() const {
 MacroProcessor::TextList
 MacroProcessor::Macro::getReplTextList(
                     const PPToken& token,
-                    const vector<string>& parentMacros,
+                    HideSet parentMacros,
                     const PredefinedMacros& predefinedMacros) const {
   TextList result;
   if (predefined) {
-    string name = token.dataStrU8();
+    const string& name = token.dataStrU8();
     PPToken replaced;
     if (name == "__LINE__") {
-      CHECK(token.line >= 1);
+      CHECK(token.line() >= 1);
       replaced = PPToken(PPTokenType::PPNumber,
-                         toVector(format("{}", token.line)));
+                         toVector(format("{}", token.line())));
     } else if (name == "__FILE__") {
-      CHECK(!token.file.empty());
+      CHECK(!token.file().empty());
       replaced = PPToken(PPTokenType::StringLiteral,
-                         stringify(token.file));
+                         stringify(token.file()));
     } else {
       replaced = predefinedMacros.get(token.dataStrU8());
     }
@@ -214,7 +202,7 @@ MacroProcessor::Macro::getReplTextList(
       for (auto& r : repl) {
         // annotate line and file info
         text.push_back(
-            TextToken(PPToken(r.token, token.file, token.line), 
+            TextToken(PPToken(r.token, token.location), 
                       parentMacros));
       }
       result.push_back(move(text));
@@ -227,14 +215,18 @@ MacroProcessor::MacroProcessor(const PredefinedMacros& predefinedMacros)
   : predefinedMacros_(predefinedMacros)
 {
   Macro predefined(Macro::Type::Object, {}, false, {}, {}, true);
-  macros_.insert(make_pair("__CPPGM__", predefined));
-  macros_.insert(make_pair("__cplusplus", predefined));
-  macros_.insert(make_pair("__STDC_HOSTED__", predefined));
-  macros_.insert(make_pair("__CPPGM_AUTHOR__", predefined));
-  macros_.insert(make_pair("__DATE__", predefined));
-  macros_.insert(make_pair("__TIME__", predefined));
-  macros_.insert(make_pair("__FILE__", predefined));
-  macros_.insert(make_pair("__LINE__", predefined));
+  for (const char* name : { "__CPPGM__", 
+                            "__cplusplus", 
+                            "__STDC_HOSTED__", 
+                            "__CPPGM_AUTHOR__", 
+                            "__DATE__", 
+                            "__TIME__", 
+                            "__FILE__", 
+                            "__LINE__" }) {
+    uint32_t id = Spellings::intern(name);
+    predefined.id = static_cast<int>(id);
+    macros_.insert(make_pair(id, predefined));
+  }
 }
 
 size_t MacroProcessor::parseParam(const vector<PPToken>& tokens, 
@@ -343,6 +335,7 @@ void MacroProcessor::define(const vector<PPToken>& tokens)
   if (i == tokens.size() || !tokens[i].isId()) {
     Throw("#define must be followed by an identifier");
   }
+  uint32_t id = tokens[i].spelling;
   string name = tokens[i++].dataStrU8();
 
   if (name == VA_ARG_STR) {
@@ -427,13 +420,14 @@ void MacroProcessor::define(const vector<PPToken>& tokens)
   }
 
   Macro macro{type, move(paramList), varArg, move(body), move(bodyOriginal)};
-  auto it = macros_.find(name);
+  macro.id = static_cast<int>(id);
+  auto it = macros_.find(id);
   if (it != macros_.end()) {
     if (it->second != macro) {
       Throw("macro redefined: {}", name);
     }
   } else {
-    macros_.insert(make_pair(name, move(macro)));
+    macros_.insert(make_pair(id, move(macro)));
     // cout << format("define <{}> to be {}\n", name, macros_[name].toStr());
   }
 }
@@ -441,6 +435,7 @@ void MacroProcessor::define(const vector<PPToken>& tokens)
 void MacroProcessor::undefine(const vector<PPToken>& tokens)
 {
   string name;
+  uint32_t id = 0;
   for (size_t i = 1; i < tokens.size(); ++i) {
     if (!tokens[i].isWhite()) {
       if (!name.empty()) {
@@ -452,6 +447,7 @@ void MacroProcessor::undefine(const vector<PPToken>& tokens)
               tokens[i].dataStrU8());
       } else {
         name = tokens[i].dataStrU8();
+        id = tokens[i].spelling;
       }
     }
   }
@@ -459,7 +455,7 @@ void MacroProcessor::undefine(const vector<PPToken>& tokens)
     Throw("Missing identifier after #undef");
   }
   // cout << format("macro {} undefined\n", name);
-  macros_.erase(name);
+  macros_.erase(id);
 }
 
 void MacroProcessor::def(const vector<PPToken>& tokens)
@@ -494,8 +490,8 @@ MacroProcessor::merge(TextList&& textList)
     } else {
       PPToken merged = mergeToken(result.back().token, text[0].token);
       result.back() = TextToken(merged, 
-                                add(result.back().parentMacros,
-                                    text[0].parentMacros));
+                                hideSets_.unite(result.back().parentMacros,
+                                                text[0].parentMacros));
 
       result.insert(result.end(), text.begin() + 1, text.end());
     }
@@ -507,7 +503,7 @@ MacroProcessor::TextList
 MacroProcessor::applyFunction(const PPToken& root,
                               const Macro& macro,
                               vector<vector<TextToken>>&& args,
-                              const vector<string>& parentMacros) {
+                              HideSet parentMacros) {
 
   size_t nparam = macro.paramList.size();
 
@@ -555,7 +551,7 @@ MacroProcessor::applyFunction(const PPToken& root,
           param = static_cast<int>(nparam);
         }
         auto& arg = args[param];
-        vector<TextToken> argText;
+        TextBuffer argText;
 
         if (r.literal) {
           // note the compiler crashing comment above.
@@ -577,12 +573,13 @@ MacroProcessor::applyFunction(const PPToken& root,
         for (auto& t : argText) {
           // t.parentMacros tracks the parent macros in the inplace replacement
           // note the compiler crashing comment above.
-          PPToken ppToken(t.token, root.file, root.line);
+          PPToken ppToken(t.token, root.location);
           text.push_back(
-            TextToken(ppToken, add(t.parentMacros, parentMacros)));
+            TextToken(ppToken, 
+                      hideSets_.unite(t.parentMacros, parentMacros)));
         }
       } else {
-        PPToken ppToken(r.token, root.file, root.line);
+        PPToken ppToken(r.token, root.location);
         text.push_back(
             TextToken(ppToken, parentMacros));
       }
@@ -594,7 +591,7 @@ MacroProcessor::applyFunction(const PPToken& root,
 }
 
 namespace {
-void debug(const vector<MacroProcessor::TextToken>& text)
+void debug(const list<MacroProcessor::TextToken>& text)
 {
   cout << "replace:";
   for (auto& t : text) {
@@ -605,114 +602,143 @@ void debug(const vector<MacroProcessor::TextToken>& text)
 }
 }
 
-// TODO: optimize names (mutate in place)
-// taking a TextToken vector is necessary, consider the case ggg(a b c d)
+// taking a TextToken list is necessary, consider the case ggg(a b c d)
 // where ggg was produced by ##
-vector<MacroProcessor::TextToken>&
-MacroProcessor::replace(vector<TextToken>& text)
+//
+// The text is rescanned in a single pass: everything before the cursor is
+// known to be not expandable, so after a substitution we resume at the start
+// of the replacement instead of from the beginning of the text. The only
+// exception is a function-like macro name which is separated from the
+// replacement by white-spaces only: the replacement may start with the '('
+// it was waiting for, so we resume at that name.
+void MacroProcessor::replace(TextBuffer& text)
 {
   // debug(text);
 
-  bool expanded;
-  do {
-    expanded = false;
-    for (auto it = text.begin(); it != text.end(); ++it) {
-      const auto& t = it->token;
-      if (!it->canExpand() || !t.isId()) {
-        continue;
+  // the last non-white token before the cursor
+  auto prev = text.end();
+  auto resume = [&](TextBuffer::iterator first) {
+    if (prev != text.end() && prev->token.isId()) {
+      first = prev;
+    }
+    prev = text.end();
+    return first;
+  };
+
+  auto it = text.begin();
+  while (it != text.end()) {
+    const auto& t = it->token;
+    if (t.isWhite() || t.isNewLine()) {
+      ++it;
+      continue;
+    }
+    if (!it->expand || !t.isId()) {
+      prev = it++;
+      continue;
+    }
+    // cout << format("expanding {}\n", t.dataStrU8());
+    auto itMacro = macros_.find(t.spelling);
+    if (itMacro == macros_.end()) {
+      prev = it++;
+      continue;
+    }
+    auto& macro = itMacro->second;
+    // a token produced by the macro itself is never expanded again, even
+    // if it is later rescanned in a different context
+    if (it->parentMacros.contains(macro.id)) {
+      it->expand = false;
+      prev = it++;
+      continue;
+    }
+    if (macro.isObject()) {
+      TimeReport::count(TimeReport::MacroExpansions);
+      auto result = merge(macro.getReplTextList(
+                            t,
+                            hideSets_.add(it->parentMacros, macro.id),
+                            predefinedMacros_));
+      it = text.erase(it);
+      it = resume(text.insert(it, 
+                              make_move_iterator(result.begin()),
+                              make_move_iterator(result.end())));
+    } else {
+      auto itEnd = next(it);
+      while (itEnd != text.end() && 
+             (itEnd->token.isWhite() || itEnd->token.isNewLine())) {
+        ++itEnd;
       }
-      // cout << format("expanding {}({})\n", t.dataStrU8(), it->parentMacros);
-      string name = t.dataStrU8();
-      auto itMacro = macros_.find(name);
-      if (itMacro == macros_.end()) {
+      if (itEnd == text.end() || !isLParen(itEnd->token)) {
+        prev = it++;
         continue;
       }
-      auto& macro = itMacro->second;
-      if (macro.isObject()) {
-        auto result = merge(macro.getReplTextList(
-                              t,
-                              add(it->parentMacros, name),
-                              predefinedMacros_));
-        it = text.erase(it);
-        text.insert(it, result.begin(), result.end());
-        expanded = true;
-        break;
-      } else {
-        auto itEnd = it + 1;
-        while (itEnd != text.end() && 
-               (itEnd->token.isWhite() || itEnd->token.isNewLine())) {
-          ++itEnd;
-        }
-        if (itEnd != text.end() && isLParen(itEnd->token)) {
-          // find matching ')' and collect arguments
-          int count = 1;
-          vector<vector<TextToken>> args(1);
-          for (++itEnd; itEnd != text.end(); ++itEnd) {
-            if (isComma(itEnd->token) && count == 1) {
-              args.push_back({});
-            } else {
-              if (!isRParen(itEnd->token) || count > 1) {
-                // keep the parent macros for this argument token
-                args.back().push_back(*itEnd);
-              }
-            }
-
-            if (isRParen(itEnd->token)) {
-              --count;
-              if (count == 0) {
-                break;
-              }
-            } else if (isLParen(itEnd->token)) {
-              ++count;
-            }
-          }
-          if (count > 0) {
-            Throw("Cannot locate matching ')' for macro invocation for {}",
-                  name);
-          }
-          CHECK(isRParen(itEnd->token));
-          ++itEnd;
-          if (args.size() == 1 && args[0].empty()) {
-            args.clear();
-          }
 
-          // trim the leading and trailing whitespaces of each arg
-          // (not including the ones corresponding to ...)
-          for (size_t i = 0; i < args.size(); ++i) {
-            if (!(macro.varArg && i >= macro.paramList.size())) {
-              trim<TextToken>(args[i], [](const TextToken& t) {
-                return t.token.isWhite() || t.token.isNewLine();
-              });
-            }
+      // find matching ')' and collect arguments
+      int count = 1;
+      vector<vector<TextToken>> args(1);
+      for (++itEnd; itEnd != text.end(); ++itEnd) {
+        if (isComma(itEnd->token) && count == 1) {
+          args.push_back({});
+        } else {
+          if (!isRParen(itEnd->token) || count > 1) {
+            // keep the parent macros for this argument token
+            args.back().push_back(*itEnd);
           }
+        }
 
-          auto result = merge(applyFunction(t, 
-                                            macro, 
-                                            move(args), 
-                                            add(it->parentMacros, name)));
-#if 0
-          cout << "argument: ";
-          for (auto& r : result) {
-            cout << format("<{}({})> ", r.token.dataStrU8(), r.parentMacros);
+        if (isRParen(itEnd->token)) {
+          --count;
+          if (count == 0) {
+            break;
           }
-          cout << "\n";
-#endif
-          it = text.erase(it, itEnd);
-          text.insert(it, result.begin(), result.end());
-          expanded = true;
-          break;
+        } else if (isLParen(itEnd->token)) {
+          ++count;
+        }
+      }
+      if (count > 0) {
+        Throw("Cannot locate matching ')' for macro invocation for {}",
+              t.dataStrU8());
+      }
+      CHECK(isRParen(itEnd->token));
+      ++itEnd;
+      if (args.size() == 1 && args[0].empty()) {
+        args.clear();
+      }
+
+      // trim the leading and trailing whitespaces of each arg
+      // (not including the ones corresponding to ...)
+      for (size_t i = 0; i < args.size(); ++i) {
+        if (!(macro.varArg && i >= macro.paramList.size())) {
+          trim<TextToken>(args[i], [](const TextToken& t) {
+            return t.token.isWhite() || t.token.isNewLine();
+          });
         }
       }
+
+      TimeReport::count(TimeReport::MacroExpansions);
+      auto result = merge(applyFunction(t, 
+                                        macro, 
+                                        move(args), 
+                                        hideSets_.add(it->parentMacros, 
+                                                      macro.id)));
+#if 0
+      cout << "argument: ";
+      for (auto& r : result) {
+        cout << format("<{}> ", r.token.dataStrU8());
+      }
+      cout << "\n";
+#endif
+      it = text.erase(it, itEnd);
+      it = resume(text.insert(it, 
+                              make_move_iterator(result.begin()),
+                              make_move_iterator(result.end())));
     }
-  } while (expanded);
+  }
 
   // cout << "<replace finished>" << endl;
-  return text;
 }
 
 vector<PPToken> MacroProcessor::expand(const vector<PPToken>& rawText)
 {
-  vector<TextToken> text;
+  TextBuffer text;
   for (auto& t : rawText) {
     if (t.isId() && t.dataStrU8() == VA_ARG_STR) {
       Throw("{} encountered in text", VA_ARG_STR);
@@ -723,7 +749,7 @@ vector<PPToken> MacroProcessor::expand(const vector<PPToken>& rawText)
   vector<PPToken> result;
   result.reserve(text.size());
   for (auto& t : text) {
-    result.push_back(PPToken(t.token));
+    result.push_back(move(t.token));
   }
   return result;
 }
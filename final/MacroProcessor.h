@@ -1,7 +1,10 @@
 #pragma once
 #include "preprocessing_token/PreprocessingToken.h"
+#include "HideSet.h"
 #include <vector>
+#include <list>
 #include <map>
+#include <unordered_map>
 #include <string>
 
 namespace compiler {
@@ -12,17 +15,17 @@ class MacroProcessor {
 public:
   using PPToken = ppToken::PPToken;
   struct TextToken {
-    explicit TextToken(const PPToken& _token, 
-                       const std::vector<std::string>& _parentMacros)
+    explicit TextToken(const PPToken& _token, HideSet _parentMacros)
       : token(_token),
         parentMacros(_parentMacros)  { }
-    bool canExpand();
     PPToken token;
-    std::vector<std::string> parentMacros;
+    HideSet parentMacros;
     bool expand { true };
   };
 private:
   typedef std::vector<std::vector<TextToken>> TextList;
+  // the text being rescanned; substitutions are spliced in place
+  typedef std::list<TextToken> TextBuffer;
 
   struct Repl {
     explicit Repl(const PPToken t, int param)
@@ -76,7 +79,7 @@ private:
 
     TextList getReplTextList(
               const PPToken& token,
-              const std::vector<std::string>& parentMacros,
+              HideSet parentMacros,
               const PredefinedMacros& predefinedMacros) const;
 
     // debugging
@@ -91,14 +94,17 @@ private:
     // TODO: get rid of this
     std::vector<PPToken> bodyOriginal;
     bool predefined;
+    // spelling id of the name, also used in hide-sets
+    int id { -1 };
   };
 
 public:
   MacroProcessor(const PredefinedMacros&);
   void def(const std::vector<PPToken>& tokens);
   std::vector<PPToken> expand(const std::vector<PPToken>& text);
-  bool isDefined(const std::string& identifier) const {
-    return macros_.find(identifier) != macros_.end();
+  // spelling is that of the identifier's PPToken
+  bool isDefined(uint32_t spelling) const {
+    return macros_.find(spelling) != macros_.end();
   }
 private:
   void define(const std::vector<PPToken>& tokens);
@@ -111,16 +117,16 @@ private:
                     const std::vector<std::string>& paramList,
                     bool varArg);
   std::vector<Repl> parseRepl(std::vector<Repl>&& repl);
-  std::vector<TextToken>& replace(std::vector<TextToken>& text);
+  void replace(TextBuffer& text);
   std::vector<TextToken> merge(TextList&& textList);
   TextList applyFunction(const PPToken& token,
                          const Macro& macro,
                          std::vector<std::vector<TextToken>>&& args,
-                         const std::vector<std::string>& parentMacros);
+                         HideSet parentMacros);
 
-  // name to macro
-  // name is utf8 data of identifier
-  std::map<std::string, Macro> macros_;
+  // spelling id of the name to macro
+  std::unordered_map<uint32_t, Macro> macros_;
+  HideSetPool hideSets_;
   const PredefinedMacros& predefinedMacros_;
 };
 }
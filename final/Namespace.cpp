@@ -1,4 +1,5 @@
 #include "Namespace.h"
+#include "TimeReport.h"
 #include "TranslationUnit.h"
 
 namespace compiler {
@@ -65,6 +66,11 @@ void Namespace::lookupMember(const string& name, MemberSet& members) const {
   }
 }
 
+void Namespace::insertMember(const string& name, SMember member) {
+  members_.insert(make_pair(name, member));
+  ++*unit_->getNameGeneration(name);
+}
+
 Namespace* Namespace::addNamespace(string name,
                                    bool unnamed, 
                                    bool isInline) {
@@ -94,7 +100,7 @@ Namespace* Namespace::addNamespace(string name,
 
   auto ns = namespaces_.back().get();
   auto m = make_shared<NamespaceMember>(this, name, ns->getLinkage(), ns);
-  members_.insert(make_pair(name, m));
+  insertMember(name, m);
   declarationOrder_.ns.push_back(m);
 
   if (unnamed || isInline) {
@@ -109,6 +115,8 @@ void Namespace::addFunction(const string& name,
                             bool requireDeclaration,
                             bool isDef,
                             const DeclSpecifiers& declSpecifiers) {
+  type = static_pointer_cast<FunctionType>(
+           unit_->getTypeContext().intern(type));
   bool internalLinkage = 
          linkage_ == Linkage::Internal ||
          declSpecifiers.getStorageClass() & StorageClass::Static;
@@ -180,7 +188,7 @@ void Namespace::addFunction(const string& name,
              internalLinkage ? Linkage::Internal : Linkage::External,
              declSpecifiers.isInline(),
              isDef);
-  members_.insert(make_pair(name, m));
+  insertMember(name, m);
   declarationOrder_.func.push_back(m);
   unit_->addMember(m);
 }
@@ -261,6 +269,7 @@ void Namespace::addVariable(const string& name,
   if (isDef) {
     checkInitializer(name, type, initializer, declSpecifiers.isConstExpr());
   }
+  type = unit_->getTypeContext().intern(type);
 
   bool internalLinkage = 
          linkage_ == Linkage::Internal ||
@@ -348,12 +357,13 @@ void Namespace::addVariable(const string& name,
                StorageDuration::Static,
              isDef,
              move(initializer));
-  members_.insert(make_pair(name, m));
+  insertMember(name, m);
   declarationOrder_.var.push_back(m);
   unit_->addMember(m);
 }
 
 void Namespace::addTypedef(const string& name, SType type) {
+  type = unit_->getTypeContext().intern(type);
   auto member = lookupMember(name);
   if (member) {
     if (member->isTypedef()) {
@@ -368,15 +378,16 @@ void Namespace::addTypedef(const string& name, SType type) {
       reportRedeclaration(name, *type, *member);
     }
   }
-  members_.insert(make_pair(name, 
-                            make_shared<TypedefMember>(this, name, type)));
+  insertMember(name, make_shared<TypedefMember>(this, name, type));
 }
 
 void Namespace::addUsingDirective(Namespace* ns) {
   if (ns == this) {
     return;
   }
-  usingDirectives_.insert(ns);
+  if (usingDirectives_.insert(ns).second) {
+    unit_->newLookupGeneration();
+  }
 }
 
 void Namespace::addUsingDeclaration(const MemberSet& ms) {
@@ -464,7 +475,7 @@ void Namespace::addUsingDeclaration(const MemberSet& ms) {
     }
 
     // cout << format("using declaration: added: {} {}", m->name, m) << endl;
-    members_.insert(make_pair(m->name, m));
+    insertMember(m->name, m);
   }
 }
 
@@ -482,39 +493,63 @@ void Namespace::addNamespaceAlias(const std::string& name,
     // duplicate aliases allowed
     return;
   }
-  members_.insert(make_pair(name, ns));
+  insertMember(name, ns);
 }
 
-Namespace::MemberSet
-Namespace::unqualifiedLookup(const string& name, 
-                             UsingDirectiveMap& usingDirectiveMap) const {
-  auto closure = getUsingDirectiveClosure();
-  // for each namespace in the closure, it's as if the members from that
-  // namespace appears in the LCA of this and that namespace
-  for (auto ns : closure) {
-    auto lca = getLCA(this, ns);
-    if (lca != ns) {
-      usingDirectiveMap[lca].insert(ns);
+auto Namespace::getLookupScopes() const -> const LookupScopes& {
+  auto& scopes = lookupScopes_;
+  if (scopes.generation == unit_->getLookupGeneration()) {
+    return scopes.value;
+  }
+  scopes.value.clear();
+  // Ns A -> [Ns]: namespace A needs to consider [Ns] in its unqualified lookup
+  map<const Namespace*, NamespaceSet> usingDirectiveMap;
+  for (auto scope = this; scope; scope = scope->parent_) {
+    // for each namespace in the closure, it's as if the members from that
+    // namespace appears in the LCA of this and that namespace
+    for (auto ns : scope->getUsingDirectiveClosure()) {
+      auto lca = getLCA(scope, ns);
+      if (lca != ns) {
+        usingDirectiveMap[lca].insert(ns);
+      }
     }
-  }
-
-  MemberSet members;
-  lookupMember(name, members);
-  // for this namespace, also lookup the members of the namespaces in the 
-  // usingDirectiveMap: it's as if those members appear in this namespace
-  for (auto ns : usingDirectiveMap[this]) {
-    ns->lookupMember(name, members); 
-  }
+    // for this namespace, also lookup the members of the namespaces in the
+    // usingDirectiveMap: it's as if those members appear in this namespace
+    auto& appearing = usingDirectiveMap[scope];
+    scopes.value.emplace_back(1, scope);
+    scopes.value.back().insert(scopes.value.back().end(),
+                               appearing.begin(),
+                               appearing.end());
+  }
+  scopes.generation = unit_->getLookupGeneration();
+  return scopes.value;
+}
 
-  if (!members.empty()) {
-    return members;
-  }
+bool Namespace::lookupCached(const LookupCache& cache,
+                             const string& name,
+                             MemberSet& members) const {
+  auto it = cache.find(name);
+  if (it == cache.end()) {
+    return false;
+  }
+  auto& cached = it->second;
+  if (cached.lookupGeneration != unit_->getLookupGeneration() ||
+      *cached.nameGeneration != cached.seenNameGeneration) {
+    return false;
+  }
+  TimeReport::count(TimeReport::LookupHits);
+  members = cached.members;
+  return true;
+}
 
-  if (parent_) {
-    return parent_->unqualifiedLookup(name, usingDirectiveMap);
-  } else {
-    return {};
-  }
+void Namespace::cacheLookup(LookupCache& cache,
+                            const string& name,
+                            const MemberSet& members) const {
+  auto nameGeneration = unit_->getNameGeneration(name);
+  cache[name] = CachedLookup { members,
+                               unit_->getLookupGeneration(),
+                               nameGeneration,
+                               *nameGeneration };
 }
 
 void Namespace::checkLookupAmbiguity(const string& name,
@@ -548,16 +583,32 @@ void Namespace::checkLookupAmbiguity(const string& name,
 }
 
 Namespace::MemberSet Namespace::unqualifiedLookup(const string& name) const {
-  UsingDirectiveMap usingDirectiveMap;
-  auto members = unqualifiedLookup(name, usingDirectiveMap);
+  MemberSet members;
+  if (lookupCached(unqualifiedLookups_, name, members)) {
+    return members;
+  }
+  for (auto& scope : getLookupScopes()) {
+    for (auto ns : scope) {
+      ns->lookupMember(name, members);
+    }
+    if (!members.empty()) {
+      break;
+    }
+  }
   checkLookupAmbiguity(name, members);
+  cacheLookup(unqualifiedLookups_, name, members);
   return members;
 }
 
 Namespace::MemberSet Namespace::qualifiedLookup(const string& name) const {
+  MemberSet members;
+  if (lookupCached(qualifiedLookups_, name, members)) {
+    return members;
+  }
   set<const Namespace*> visited;
-  MemberSet members = qualifiedLookup(name, visited);
+  members = qualifiedLookup(name, visited);
   checkLookupAmbiguity(name, members);
+  cacheLookup(qualifiedLookups_, name, members);
   return members;
 }
 
@@ -571,8 +622,7 @@ Namespace::qualifiedLookup(const string& name, NamespaceSet& visited) const {
   MemberSet members;
   lookupMember(name, members);
   // lookup inline namespaces as well
-  auto closure = getInlineNamespaceClosure();
-  for (auto ns : closure) {
+  for (auto ns : getInlineNamespaceClosure()) {
     ns->lookupMember(name, members);
   }
 
@@ -608,12 +658,16 @@ Namespace::lookupNamespace(const string& name, bool qualified) const
   return (*members.begin())->toNamespace();
 }
 
-auto Namespace::getUsingDirectiveClosure() const -> NamespaceSet {
-  NamespaceSet closure;
-  closure.insert(this);
-  getUsingDirectiveClosure(closure);
-  closure.erase(this);
-  return closure;
+auto Namespace::getUsingDirectiveClosure() const -> const NamespaceSet& {
+  auto& closure = usingDirectiveClosure_;
+  if (closure.generation != unit_->getLookupGeneration()) {
+    closure.value.clear();
+    closure.value.insert(this);
+    getUsingDirectiveClosure(closure.value);
+    closure.value.erase(this);
+    closure.generation = unit_->getLookupGeneration();
+  }
+  return closure.value;
 }
 
 void Namespace::getUsingDirectiveClosure(NamespaceSet& closure) const {
@@ -625,10 +679,14 @@ void Namespace::getUsingDirectiveClosure(NamespaceSet& closure) const {
   }
 }
 
-auto Namespace::getInlineNamespaceClosure() const -> NamespaceSet {
-  NamespaceSet closure;
-  getInlineNamespaceClosure(closure);
-  return closure;
+auto Namespace::getInlineNamespaceClosure() const -> const NamespaceSet& {
+  auto& closure = inlineNamespaceClosure_;
+  if (closure.generation != unit_->getLookupGeneration()) {
+    closure.value.clear();
+    getInlineNamespaceClosure(closure.value);
+    closure.generation = unit_->getLookupGeneration();
+  }
+  return closure.value;
 }
 
 void Namespace::getInlineNamespaceClosure(NamespaceSet& closure) const {
@@ -4,6 +4,7 @@
 #include "Type.h"
 #include "DeclSpecifiers.h"
 #include "Member.h"
+#include <unordered_map>
 
 namespace compiler {
 
@@ -68,20 +69,38 @@ class Namespace {
 
   SMember lookupMember(const std::string &name) const;
   void lookupMember(const std::string &name, MemberSet& members) const;
+  void insertMember(const std::string& name, SMember member);
 
   void getUsingDirectiveClosure(NamespaceSet& closure) const;
-  NamespaceSet getUsingDirectiveClosure() const;
+  const NamespaceSet& getUsingDirectiveClosure() const;
   void getInlineNamespaceClosure(NamespaceSet& closure) const;
-  NamespaceSet getInlineNamespaceClosure() const;
+  const NamespaceSet& getInlineNamespaceClosure() const;
+
+  // The namespaces unqualified lookup looks in, scope by scope from this
+  // one outwards: each enclosing namespace, and those whose members appear
+  // in it through a using-directive (in the LCA of the two)
+  using LookupScopes = std::vector<std::vector<const Namespace*>>;
+  const LookupScopes& getLookupScopes() const;
 
-  // Ns A -> [Ns]: namespace A needs to consider [Ns] in its unqualified lookup
-  using UsingDirectiveMap = std::map<const Namespace*, NamespaceSet>;
   void checkLookupAmbiguity(const std::string& name, MemberSet& members) const;
-  MemberSet unqualifiedLookup(const std::string& name, 
-                              UsingDirectiveMap& usingDirectiveMap) const;
   MemberSet qualifiedLookup(const std::string& name, 
                             NamespaceSet& visited) const;
 
+  // what a lookup of a name found, as of the generations of the unit
+  struct CachedLookup {
+    MemberSet members;
+    uint64_t lookupGeneration;
+    const uint64_t* nameGeneration;
+    uint64_t seenNameGeneration;
+  };
+  using LookupCache = std::unordered_map<std::string, CachedLookup>;
+  bool lookupCached(const LookupCache& cache, 
+                    const std::string& name,
+                    MemberSet& members) const;
+  void cacheLookup(LookupCache& cache,
+                   const std::string& name,
+                   const MemberSet& members) const;
+
   void checkInitializer(const std::string& name, 
                         SType& type, 
                         UInitializer& initializer,
@@ -104,6 +123,19 @@ class Namespace {
     std::vector<SFunctionMember> func;
     std::vector<SNamespaceMember> ns;
   } declarationOrder_;
+
+  // computed on demand, and again once the lookup generation of the unit
+  // has moved on
+  template<typename T>
+  struct Cached {
+    uint64_t generation { UINT64_MAX };
+    T value;
+  };
+  mutable Cached<NamespaceSet> usingDirectiveClosure_;
+  mutable Cached<NamespaceSet> inlineNamespaceClosure_;
+  mutable Cached<LookupScopes> lookupScopes_;
+  mutable LookupCache unqualifiedLookups_;
+  mutable LookupCache qualifiedLookups_;
 };
 
 inline std::ostream& operator<<(std::ostream& out, const Namespace& ns) {
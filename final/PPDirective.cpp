@@ -4,6 +4,7 @@
 #include "PostTokenReceiver.h"
 #include "Tokenizer.h"
 #include "SourceReader.h"
+#include "TimeReport.h"
 #include "common.h"
 #include <sstream>
 
@@ -111,7 +112,7 @@ bool PPDirective::evaluateIf(const vector<PPToken>& dirs)
   directive.reserve(dirs.size());
   int state = 0;
   size_t start = 0;
-  string identifier;
+  uint32_t identifier = 0;
   bool matched = false;
   for (size_t i = 1; i < dirs.size(); ++i) {
     switch (state) {
@@ -123,7 +124,7 @@ bool PPDirective::evaluateIf(const vector<PPToken>& dirs)
         break;
       case 1:
         if (dirs[i].isId()) {
-          identifier = dirs[i].dataStrU8();
+          identifier = dirs[i].spelling;
           matched = true;
         } else if (isLParen(dirs[i])) {
           state = 2;
@@ -133,7 +134,7 @@ bool PPDirective::evaluateIf(const vector<PPToken>& dirs)
         break;
       case 2:
         if (dirs[i].isId()) {
-          identifier = dirs[i].dataStrU8();
+          identifier = dirs[i].spelling;
           state = 3;
         } else if (!dirs[i].isWhite()) {
           state = 0;
@@ -153,7 +154,7 @@ bool PPDirective::evaluateIf(const vector<PPToken>& dirs)
     if (matched) {
       matched = false;
       state = 0;
-      CHECK(!identifier.empty());
+      CHECK(identifier != 0);
       bool defined = macroProcessor_.isDefined(identifier);
       directive.erase(directive.begin() + start, directive.end());
       
@@ -196,7 +197,7 @@ void PPDirective::handleIf(const vector<PPToken>& directive) {
     if (i == directive.size() || !directive[i].isId()) {
       Throw("Expect identifider after {}", dir);
     }
-    bool defined = macroProcessor_.isDefined(directive[i].dataStrU8());
+    bool defined = macroProcessor_.isDefined(directive[i].spelling);
     if (dir == "ifndef") {
       defined = ! defined;
     }
@@ -253,6 +254,7 @@ void PPDirective::handleEndif(const vector<PPToken>& directive)
 
 void PPDirective::handleInclude(const vector<PPToken>& dirs)
 {
+  TimeReport::count(TimeReport::Includes);
   auto expanded = macroProcessor_.expand(
                     vector<PPToken>(dirs.begin() + 1, dirs.end()));
   size_t i = skipWhite(expanded, 0);
@@ -336,7 +338,7 @@ void PPDirective::handlePragma(const vector<PPToken>& dirs)
     return;
   }
 
-  sourceReader_->pragmaOnce(dirs[0].file);
+  sourceReader_->pragmaOnce(dirs[0].file());
 }
 
 void PPDirective::handleDirective()
@@ -431,7 +433,7 @@ void PPDirective::handleExpand()
       CHECK(type.back() == '"');
       type.pop_back();
       if (type == "once") {
-        sourceReader_->pragmaOnce(token.file);
+        sourceReader_->pragmaOnce(token.file());
       }
     }
   }
@@ -439,13 +441,15 @@ void PPDirective::handleExpand()
 
 void PPDirective::put(const PPToken& t)
 {
+  TimeReport::Scope scope(TimeReport::Preprocessor);
+  TimeReport::count(TimeReport::PPTokens);
   // TODO: optimize away this copy
   PPToken token = t;
   // track __FILE__ and __LINE__ for identifier (because only identifiers
   // have the potential of becoming __FILE__ or __LINE__)
   if (token.isId()) {
-    token.line = sourceReader_->line();
-    token.file = sourceReader_->file();
+    token.location = SourceLocations::intern(sourceReader_->file(),
+                                             sourceReader_->line());
   }
 
   bool isText = true;
@@ -460,6 +464,11 @@ void PPDirective::put(const PPToken& t)
     if (state_ == 1) {
       handleDirective();
       isText = false;
+      if (!isEnabled(0) && sourceReader_) {
+        // nothing in a skipped group but the directives which end it matters,
+        // so bypass the pp-tokenizer for it
+        sourceReader_->skipGroup();
+      }
     }
     state_ = 0;
   } else {
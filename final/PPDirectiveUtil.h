@@ -3,36 +3,43 @@
 
 namespace compiler {
 
+// spelling ids of the punctuators the preprocessor looks for
+inline bool isPunctuator(const ppToken::PPToken& token, uint32_t spelling) {
+  return token.is(ppToken::PPTokenType::PPOpOrPunc, spelling);
+}
+
 inline bool isPound(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc && 
-         (token.dataStrU8() == "#" ||
-          token.dataStrU8() == "%:");
+  static const uint32_t pound = ppToken::Spellings::intern("#");
+  static const uint32_t percentColon = ppToken::Spellings::intern("%:");
+  return isPunctuator(token, pound) || isPunctuator(token, percentColon);
 }
 
 inline bool isDoublePound(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc &&
-         (token.dataStrU8() == "##" ||
-          token.dataStrU8() == "%:%:");
+  static const uint32_t doublePound = ppToken::Spellings::intern("##");
+  static const uint32_t doublePercentColon =
+    ppToken::Spellings::intern("%:%:");
+  return isPunctuator(token, doublePound) ||
+         isPunctuator(token, doublePercentColon);
 }
 
 inline bool isLParen(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc &&
-         token.dataStrU8() == "(";
+  static const uint32_t lParen = ppToken::Spellings::intern("(");
+  return isPunctuator(token, lParen);
 }
 
 inline bool isRParen(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc &&
-         token.dataStrU8() == ")";
+  static const uint32_t rParen = ppToken::Spellings::intern(")");
+  return isPunctuator(token, rParen);
 }
 
 inline bool isEllipse(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc &&
-         token.dataStrU8() == "...";
+  static const uint32_t ellipse = ppToken::Spellings::intern("...");
+  return isPunctuator(token, ellipse);
 }
 
 inline bool isComma(const ppToken::PPToken& token) {
-  return token.type == ppToken::PPTokenType::PPOpOrPunc &&
-         token.dataStrU8() == ",";
+  static const uint32_t comma = ppToken::Spellings::intern(",");
+  return isPunctuator(token, comma);
 }
 
 inline bool isIdentifier(const ppToken::PPToken& token, const std::string& identifier) {
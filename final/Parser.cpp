@@ -20,12 +20,24 @@
 //    class C { };
 
 #include "Parser.h"
+#include "FirstSets.h"
 #include "NameUtility.h"
+#include "parsers/FunctionBodies.h"
+#include "parsers/ParseFailure.h"
+#include "RuleProfile.h"
+#include "TimeReport.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <functional>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 
 #define LOG() cout << format("[{}] index={} [{}]\n", \
                              __FUNCTION__, index_, cur().toStr());
@@ -35,20 +47,36 @@
 // the macro feature
 #define expectM(type, name, ...) \
   expectMultipleFromFunc(type, name, __VA_ARGS__, __FUNCTION__)
-#define BAD_EXPECT(msg) complainExpect(msg, __FUNCTION__)
+#define BAD_EXPECT(msg) return complainExpect(msg, __FUNCTION__)
 
 // traced call
 #define TR(func) tracedCall(&ParserImp::func, #func)
 #define TRF(func) ([this]() -> AST \
                    { return tracedCall(&ParserImp::func, #func); })
-// backtracked call - can be later optimized away by using FIRST and FOLLOW
+// backtracked call - not tried if FIRST rules it out, see RecognizerGrammar
 #define BT(func) backtrack(&ParserImp::func, #func)
 #define BTF(func) ([this]() -> AST \
                    { return backtrack(&ParserImp::func, #func); })
 
 #define zeroOrMore(func) zeroOrMoreInternal(c, BTF(func));
 #define zeroOrOne(func) zeroOrOneInternal(c, BTF(func));
-#define oneOrMore(func) oneOrMoreInternal(c, TRF(func), BTF(func));
+#define oneOrMore(func) do { \
+    if (!oneOrMoreInternal(c, TRF(func), BTF(func))) { \
+      return nullptr; \
+    } \
+  } while (false)
+
+// A rule that fails returns nullptr with failed_ set, and so does every
+// rule on the way up to the attempt() or parse() that handles it. PUSH
+// adds what a rule or an expected token returned to the children c, or
+// passes its failure on.
+#define PUSH(node) do { \
+    AST pushed = (node); \
+    if (!pushed) { \
+      return nullptr; \
+    } \
+    c.push_back(pushed); \
+  } while (false)
 
 #define getAST(type) get(ASTType::type, move(c))
 
@@ -61,49 +89,698 @@ namespace compiler {
 
 using namespace std;
 
-// TODO: this function can be optimized by using a single ostringstream
-// as the "environment"
-string ASTNode::toStr(string indent, bool collapse) const {
-  const char* indentInc = "|  ";
+string ASTNode::toStr(const TokenBuffer& tokens,
+                      string indent,
+                      bool collapse) const {
   ostringstream oss;
-  if (isTerminal) {
-    oss << indent;
-    if (type != ASTType::Terminal) {
-      oss << getASTTypeName(type) << ": ";
+  ASTWriter(oss, tokens).writeText(this, collapse, indent);
+  return oss.str();
+}
+
+void ASTWriter::writeText(AST root, bool collapse, const string& indent) {
+  indent_ = indent;
+  text(root, collapse);
+}
+
+void ASTWriter::text(AST node, bool collapse) {
+  const char* indentInc = "|  ";
+  if (node->isTerminal) {
+    put(indent_);
+    if (node->type != ASTType::Terminal) {
+      put(typeName(node->type));
+      put(": ", 2);
     }
-    oss << token->toSimpleStr();
+    put(tokens_.toSimpleStr(node->token));
   } else {
     // if this node has a single child and collapse is enabled,
     // do not print the enclosing node and don't indent
-    if (collapse && children.size() == 1) {
-      oss << children.front()->toStr(indent, collapse);
+    if (collapse && node->children.size() == 1) {
+      text(node->children.front(), collapse);
     } else {
-      oss << indent << getASTTypeName(type) << ":";
-      for (auto& child : children) {
-        oss << "\n" << child->toStr(indent + indentInc, collapse);
+      put(indent_);
+      put(typeName(node->type));
+      put(":", 1);
+      indent_ += indentInc;
+      for (auto& child : node->children) {
+        put("\n", 1);
+        text(child, collapse);
       }
+      indent_.resize(indent_.size() - strlen(indentInc));
     }
   }
-  return oss.str();
+}
+
+void ASTWriter::writeBinary(AST root) {
+  put("AST1", 4);
+  // Terminal has no name
+  size_t n = static_cast<size_t>(ASTType::TranslationUnit) + 1;
+  putVarint(n - 1);
+  for (size_t i = 1; i < n; ++i) {
+    putVarint(i);
+    const string& name = typeName(static_cast<ASTType>(i));
+    putVarint(name.size());
+    put(name);
+  }
+  terminalIds_.clear();
+  binary(root);
+}
+
+void ASTWriter::binary(AST node) {
+  putVarint(static_cast<uint64_t>(node->type) << 1 | node->isTerminal);
+  if (node->isTerminal) {
+    string text = tokens_.toSimpleStr(node->token);
+    auto it = terminalIds_.find(text);
+    if (it != terminalIds_.end()) {
+      putVarint(it->second << 1);
+    } else {
+      uint64_t id = terminalIds_.size();
+      putVarint(id << 1 | 1);
+      putVarint(text.size());
+      put(text);
+      terminalIds_.emplace(move(text), id);
+    }
+  } else {
+    putVarint(node->children.size());
+    for (auto& child : node->children) {
+      binary(child);
+    }
+  }
+}
+
+const string& ASTWriter::typeName(ASTType type) {
+  size_t i = static_cast<size_t>(type);
+  if (i >= typeNames_.size()) {
+    typeNames_.resize(i + 1);
+  }
+  if (typeNames_[i].empty()) {
+    typeNames_[i] = getASTTypeName(type);
+  }
+  return typeNames_[i];
+}
+
+void ASTWriter::put(const char* s, size_t n) {
+  buffer_.append(s, n);
+  if (buffer_.size() >= (1 << 16)) {
+    flush();
+  }
+}
+
+void ASTWriter::putVarint(uint64_t n) {
+  char bytes[10];
+  size_t len = 0;
+  do {
+    bytes[len] = static_cast<char>(n & 0x7f);
+    n >>= 7;
+    if (n) {
+      bytes[len] |= 0x80;
+    }
+    ++len;
+  } while (n);
+  put(bytes, len);
+}
+
+void ASTWriter::flush() {
+  out_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+namespace {
+
+class BinaryASTDecoder
+{
+public:
+  BinaryASTDecoder(istream& in, ostream& out, bool collapse)
+    : in_(in),
+      out_(out),
+      collapse_(collapse) { }
+
+  void decode() {
+    if (getText(4) != "AST1") {
+      Throw("not a binary AST");
+    }
+    size_t n = getVarint();
+    typeNames_.resize(n + 1);
+    for (size_t i = 0; i < n; ++i) {
+      size_t type = getVarint();
+      if (type >= typeNames_.size()) {
+        Throw("AST type {} out of range", type);
+      }
+      typeNames_[type] = getText(getVarint());
+    }
+    node("");
+    out_ << endl;
+  }
+
+private:
+  // the text of a node and its children, at indent
+  void node(const string& indent) {
+    uint64_t tag = getVarint();
+    size_t type = tag >> 1;
+    if (type >= typeNames_.size()) {
+      Throw("AST type {} out of range", type);
+    }
+    if (tag & 1) {
+      uint64_t id = getVarint();
+      if (id & 1) {
+        terminals_.push_back(getText(getVarint()));
+      }
+      id >>= 1;
+      if (id >= terminals_.size()) {
+        Throw("terminal {} out of range", id);
+      }
+      out_ << indent;
+      // Terminal has no name
+      if (type != 0) {
+        out_ << typeNames_[type] << ": ";
+      }
+      out_ << terminals_[id];
+    } else {
+      uint64_t count = getVarint();
+      if (collapse_ && count == 1) {
+        node(indent);
+        return;
+      }
+      out_ << indent << typeNames_[type] << ":";
+      for (uint64_t i = 0; i < count; ++i) {
+        out_ << "\n";
+        node(indent + "|  ");
+      }
+    }
+  }
+
+  uint64_t getVarint() {
+    uint64_t n = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      int c = in_.get();
+      if (c == EOF) {
+        Throw("binary AST ends early");
+      }
+      n |= static_cast<uint64_t>(c & 0x7f) << shift;
+      if (!(c & 0x80)) {
+        return n;
+      }
+    }
+    Throw("varint too long in binary AST");
+    return 0;
+  }
+
+  string getText(size_t n) {
+    string text(n, '\0');
+    if (!in_.read(&text[0], n)) {
+      Throw("binary AST ends early");
+    }
+    return text;
+  }
+
+  istream& in_;
+  ostream& out_;
+  bool collapse_;
+  vector<string> typeNames_;
+  vector<string> terminals_;
+};
+
+}
+
+void decodeBinaryAST(istream& in, ostream& out, bool collapse) {
+  BinaryASTDecoder(in, out, collapse).decode();
+}
+
+namespace {
+
+// The leading symbols of every rule in ParserImp, from which backtrack()
+// learns which rules cannot start with the current token (see FirstSets.h).
+// Keep in step with the rules below.
+const vector<const char*> RecognizerGrammar {
+  "translationUnit: declaration* eof",
+  "constantExpression: conditionalExpression",
+  "conditionalExpression: logicalOrExpression",
+  "logicalOrExpression: logicalAndExpression",
+  "logicalAndExpression: inclusiveOrExpression",
+  "expression: assignmentExpression",
+  "assignmentExpression: throwExpression | logicalOrExpression",
+  "inclusiveOrExpression: exclusiveOrExpression",
+  "exclusiveOrExpression: andExpression",
+  "andExpression: equalityExpression",
+  "equalityExpression: relationalExpression",
+  "relationalExpression: shiftExpression",
+  "shiftExpression: additiveExpression",
+  "additiveExpression: mulplicativeExpression",
+  "mulplicativeExpression: pmExpression",
+  "pmExpression: castExpression",
+  "castExpression: castOperator | unaryExpression",
+  "castOperator: OP_LPAREN",
+  "unaryExpression: KW_SIZEOF | KW_ALIGNOF | OP_INC | OP_DEC | OP_STAR | "
+    "OP_AMP | OP_PLUS | OP_MINUS | OP_LNOT | OP_COMPL | noExceptExpression | "
+    "newExpression | deleteExpression | postfixExpression",
+  "postfixExpression: postfixRoot",
+  "postfixSuffix: OP_INC | OP_DEC | OP_LSQUARE | OP_LPAREN | OP_DOT | "
+    "OP_ARROW",
+  "pseudoDestructorName: pseudoDestructorNameA | pseudoDestructorNameB",
+  "pseudoDestructorNameA: nestedNameSpecifier? OP_COMPL",
+  "pseudoDestructorNameB: OP_COMPL",
+  "postfixRoot: KW_DYNAMIC_CAST | KW_STATIC_CAST | KW_REINTERPET_CAST | "
+    "KW_CONST_CAST | KW_TYPEID | primaryExpression | simpleTypeSpecifier | "
+    "typenameSpecifier",
+  "primaryExpression: KW_TRUE | KW_FALSE | KW_NULLPTR | KW_THIS | literal | "
+    "OP_LPAREN | lambdaExpression | idExpression",
+  "noExceptExpression: KW_NOEXCEPT",
+  "declaration: blockDeclaration | functionDefinition | templateDeclaration | "
+    "explicitInstantiation | explicitSpecialization | linkageSpecification | "
+    "namespaceDefinition | emptyDeclaration | attributeDeclaration",
+  "blockDeclaration: simpleDeclaration | asmDefinition | "
+    "namespaceAliasDefinition | usingDeclaration | usingDirective | "
+    "staticAssertDeclaration | aliasDeclaration | opaqueEnumDeclaration",
+  "simpleDeclaration: attributeSpecifier* declSpecifierSeq",
+  "initDeclaratorList: initDeclarator",
+  "initDeclarator: declarator",
+  "initializer: OP_LPAREN | braceOrEqualInitializer",
+  "asmDefinition: KW_ASM",
+  "namespaceAliasDefinition: KW_NAMESPACE",
+  "qualifiedNamespaceSpecifier: nestedNameSpecifier? namespaceName",
+  "usingDirective: attributeSpecifier* KW_USING",
+  "opaqueEnumDeclaration: enumKey",
+  "explicitInstantiation: KW_EXTERN? KW_TEMPLATE",
+  "explicitSpecialization: KW_TEMPLATE",
+  "linkageSpecification: KW_EXTERN",
+  "namespaceDefinition: KW_INLINE? KW_NAMESPACE",
+  "namespaceBody: declaration*",
+  "emptyDeclaration: OP_SEMICOLON",
+  "attributeDeclaration: attributeSpecifier",
+  "declarator: ptrDeclarator | noptrDeclarator",
+  "ptrDeclarator: ptrOperator* noptrDeclarator",
+  "noptrDeclarator: noptrDeclaratorRoot",
+  "noptrDeclaratorRoot: OP_LPAREN | declaratorId",
+  "declaratorId: OP_DOTS? idExpression",
+  "noptrDeclaratorSuffix: OP_LSQUARE | parametersAndQualifiers",
+  "parametersAndQualifiers: OP_LPAREN",
+  "parameterDeclarationClause: parameterDeclarationClauseA | "
+    "parameterDeclarationClauseB",
+  "parameterDeclarationClauseA: parameterDeclarationList",
+  "parameterDeclarationClauseB: parameterDeclarationList? OP_DOTS?",
+  "parameterDeclarationList: parameterDeclaration",
+  "parameterDeclaration: attributeSpecifier* declSpecifierSeq",
+  "parameterDeclarationSuffixA: declarator",
+  "parameterDeclarationSuffixB: abstractDeclarator? OP_ASS?",
+  "refQualifier: OP_AMP | OP_LAND",
+  "exceptionSpecification: dynamicExceptionSpecification | "
+    "noexceptSpecification",
+  "dynamicExceptionSpecification: KW_THROW",
+  "typeIdList: typeIdDots",
+  "typeIdDots: typeId",
+  "typeId: typeSpecifierSeq",
+  "abstractDeclarator: ptrAbstractDeclarator | abstractPackDeclarator | "
+    "noptrAbstractDeclarator? trailingReturnType",
+  "ptrAbstractDeclarator: ptrAbstractDeclaratorA | ptrAbstractDeclaratorB",
+  "ptrAbstractDeclaratorA: ptrOperator* noptrAbstractDeclarator",
+  "ptrAbstractDeclaratorB: ptrOperator",
+  "abstractPackDeclarator: ptrOperator* noptrAbstractDeclarator",
+  "noptrAbstractDeclarator: OP_DOTS",
+  "trailingReturnType: OP_ARROW",
+  "trailingTypeSpecifierSeq: trailingTypeSpecifier",
+  "noexceptSpecification: KW_NOEXCEPT",
+  "noexceptSpecificationSuffix: OP_LPAREN",
+  "exceptionDeclaration: OP_DOTS | attributeSpecifier* typeSpecifier",
+  "conditionDeclaration: attributeSpecifier* declSpecifierSeq",
+  "declarationStatement: blockDeclaration",
+  "idExpression: qualifiedId | unqualifiedId",
+  "unqualifiedId: KW_OPERATOR | OP_COMPL | templateId | identifier",
+  "operatorFunctionId: KW_OPERATOR",
+  "literalOperatorId: KW_OPERATOR",
+  "conversionFunctionId: KW_OPERATOR",
+  "conversionTypeId: typeSpecifierSeq",
+  "typeSpecifierSeq: typeSpecifier",
+  "typeSpecifier: enumSpecifier | classSpecifier | trailingTypeSpecifier",
+  "enumSpecifier: enumHead",
+  "enumHead: enumKey",
+  "enumBase: OP_COLON",
+  "enumKey: KW_ENUM",
+  "enumeratorList: enumeratorDefinition",
+  "enumeratorDefinition: identifier",
+  "nestedNameSpecifier: nestedNameSpecifierRoot",
+  "nestedNameSpecifierRoot: decltypeSpecifier | OP_COLON2? namespaceName | "
+    "OP_COLON2? typeName",
+  "nestedNameSpecifierSuffix: identifier | KW_TEMPLATE? simpleTemplateId",
+  "trailingTypeSpecifier: simpleTypeSpecifier | elaboratedTypeSpecifier | "
+    "typenameSpecifier | cvQualifier",
+  "simpleTypeSpecifier: KW_CHAR | KW_CHAR16_T | KW_CHAR32_T | KW_WCHAR_T | "
+    "KW_BOOL | KW_SHORT | KW_INT | KW_LONG | KW_SIGNED | KW_UNSIGNED | "
+    "KW_FLOAT | KW_DOUBLE | KW_VOID | KW_AUTO | decltypeSpecifier | "
+    "nestedNameSpecifier? typeName",
+  "elaboratedTypeSpecifier: KW_ENUM | classKey",
+  "elaboratedTypeSpecifierA: attributeSpecifier* nestedNameSpecifier? "
+    "identifier",
+  "elaboratedTypeSpecifierB: nestedNameSpecifier? KW_TEMPLATE? "
+    "simpleTemplateId",
+  "typenameSpecifier: KW_TYPENAME",
+  "cvQualifier: KW_CONST | KW_VOLATILE",
+  "attributeSpecifier: OP_LSQUARE | alignmentSpecifier",
+  "alignmentSpecifier: KW_ALIGNAS",
+  "attributeList: attributePart",
+  "attributePart: attribute?",
+  "attribute: attributeToken",
+  "attributeArgumentClause: OP_LPAREN",
+  "balancedToken: any",
+  "attributeToken: attributeScopedToken | identifier",
+  "attributeScopedToken: attributeNamespace",
+  "attributeNamespace: identifier",
+  "ptrOperator: OP_AMP | OP_LAND | OP_STAR | nestedNameSpecifier",
+  "classSpecifier: classHead",
+  "classHead: classKey",
+  "classKey: KW_CLASS | KW_STRUCT | KW_UNION",
+  "classHeadName: nestedNameSpecifier? className",
+  "baseClause: OP_COLON",
+  "baseSpecifierList: baseSpecifierDots",
+  "baseSpecifierDots: baseSpecifer",
+  "baseSpecifer: attributeSpecifier* KW_VIRTUAL | "
+    "attributeSpecifier* accessSpecifier | "
+    "attributeSpecifier* baseTypeSpecifier",
+  "baseTypeSpecifier: classOrDecltype",
+  "classOrDecltype: decltypeSpecifier | nestedNameSpecifier? className",
+  "accessSpecifier: KW_PRIVATE | KW_PROTECTED | KW_PUBLIC",
+  "memberSpecification: accessSpecifier | memberDeclaration",
+  "memberDeclaration: usingDeclaration | staticAssertDeclaration | "
+    "templateDeclaration | aliasDeclaration | functionDefinition | "
+    "attributeSpecifier* declSpecifierSeq",
+  "declSpecifierSeq: declSpecifier",
+  "declSpecifier: KW_FRIEND | KW_TYPEDEF | KW_CONSTEXPR | "
+    "storageClassSpecifier | typeSpecifier | functionSpecifier",
+  "storageClassSpecifier: KW_REGISTER | KW_STATIC | KW_THREAD_LOCAL | "
+    "KW_EXTERN | KW_MUTABLE",
+  "functionSpecifier: KW_INLINE | KW_VIRTUAL | KW_EXPLICIT",
+  "memberDeclaratorList: memberDeclarator",
+  "memberDeclarator: declarator | identifier? attributeSpecifier* OP_COLON",
+  "braceOrEqualInitializer: OP_ASS | bracedInitList",
+  "pureSpecifier: OP_ASS",
+  "functionDefinition: attributeSpecifier* declSpecifierSeq",
+  "functionBody: OP_ASS | functionTryBlock | ctorInitializer | "
+    "compoundStatement",
+  "ctorInitializer: OP_COLON",
+  "memInitialierList: memInitialierDots",
+  "memInitialierDots: memInitialier",
+  "memInitialier: memInitialierId",
+  "memInitialierId: classOrDecltype | identifier",
+  "expressionList: initializerList",
+  "compoundStatement: OP_LBRACE",
+  "functionTryBlock: KW_TRY",
+  "handler: KW_CATCH",
+  "virtSpecifier: identifier",
+  "usingDeclaration: KW_USING",
+  "staticAssertDeclaration: KW_STATIC_ASSERT",
+  "templateDeclaration: KW_TEMPLATE",
+  "templateParameterList: templateParameter",
+  "templateParameter: typeParameter | parameterDeclaration",
+  "typeParameter: KW_CLASS | KW_TYPENAME | KW_TEMPLATE",
+  "typeParameterSuffixA: OP_DOTS? identifier?",
+  "typeParameterSuffixB: identifier? OP_ASS",
+  "typeParameterSuffixC: identifier? OP_ASS",
+  "aliasDeclaration: KW_USING",
+  "statement: labeledStatement | declarationStatement | "
+    "attributeSpecifier* expressionStatement | "
+    "attributeSpecifier* compoundStatement | "
+    "attributeSpecifier* selectionStatement | "
+    "attributeSpecifier* iterationStatement | "
+    "attributeSpecifier* jumpStatement | attributeSpecifier* tryBlock",
+  "labeledStatement: attributeSpecifier* KW_CASE | "
+    "attributeSpecifier* KW_DEFAULT | attributeSpecifier* identifier",
+  "expressionStatement: expression? OP_SEMICOLON",
+  "selectionStatement: KW_SWITCH | KW_IF",
+  "iterationStatement: KW_WHILE | KW_DO | KW_FOR",
+  "forTraditionalSpecifier: forInitStatement",
+  "forRangeBasedSpecifier: forRangeDeclaration",
+  "forInitStatement: expressionStatement | simpleDeclaration",
+  "forRangeDeclaration: attributeSpecifier* declSpecifierSeq",
+  "forRangeInitializer: bracedInitList | expression",
+  "jumpStatement: KW_BREAK | KW_CONTINUE | KW_RETURN | KW_GOTO",
+  "tryBlock: KW_TRY",
+  "condition: conditionDeclaration | expression",
+  "className: identifier",
+  "typeName: className | enumName | typedefName | simpleTemplateId",
+  "namespaceName: identifier",
+  "enumName: identifier",
+  "typedefName: identifier",
+  "simpleTemplateId: identifier",
+  "templateArgumentList: templateArgumentDots",
+  "templateArgumentDots: templateArgument",
+  "templateArgument: idExpression | constantExpression | typeId",
+  "closeAngleBracket: OP_GT | OP_RSHIFT_1 | OP_RSHIFT_2",
+  "qualifiedId: qualifiedIdA | OP_COLON2",
+  "templateId: simpleTemplateId | operatorFunctionId | literalOperatorId",
+  "qualifiedIdA: nestedNameSpecifier",
+  "decltypeSpecifier: KW_DECLTYPE",
+  "lambdaExpression: lambdaIntroducer",
+  "lambdaIntroducer: OP_LSQUARE",
+  "lambdaDeclarator: OP_LPAREN",
+  "lambdaCapture: captureDefault | captureList",
+  "captureDefault: OP_AMP | OP_ASS",
+  "captureList: captureListAtom",
+  "captureListAtom: capture",
+  "capture: KW_THIS | OP_AMP? identifier",
+  "newExpression: OP_COLON2? KW_NEW",
+  "newInitializer: OP_LPAREN | bracedInitList",
+  "newPlacement: OP_LPAREN",
+  "newTypeId: typeSpecifierSeq",
+  "newDeclarator: newDeclaratorA | newDeclaratorB",
+  "newDeclaratorA: ptrOperator* noptrNewDeclarator",
+  "newDeclaratorB: ptrOperator",
+  "noptrNewDeclarator: OP_LSQUARE",
+  "noptrNewDeclaratorSuffix: OP_LSQUARE",
+  "deleteExpression: OP_COLON2? KW_DELETE",
+  "initializerClause: bracedInitList | assignmentExpression",
+  "bracedInitList: OP_LBRACE",
+  "initializerList: initializerClauseDots",
+  "initializerClauseDots: initializerClause",
+  "throwExpression: KW_THROW",
+};
+
+// Work items [0, n) dealt out to workers in contiguous runs, so that each
+// keeps to a stretch of the tokens. A worker takes from the front of its
+// own run; once that is used up it steals the back half of the longest
+// run left.
+class WorkRuns
+{
+public:
+  WorkRuns(size_t n, size_t numWorkers) {
+    for (size_t w = 0; w < numWorkers; ++w) {
+      runs_.push_back(Run { n * w / numWorkers, n * (w + 1) / numWorkers });
+    }
+  }
+
+  // false once no work is left anywhere
+  bool take(size_t worker, size_t& item) {
+    lock_guard<mutex> lock(mutex_);
+    Run& own = runs_[worker];
+    if (own.begin == own.end) {
+      Run* victim = &own;
+      for (auto& run : runs_) {
+        if (run.end - run.begin > victim->end - victim->begin) {
+          victim = &run;
+        }
+      }
+      if (victim == &own) {
+        return false;
+      }
+      size_t half = (victim->end - victim->begin + 1) / 2;
+      own.end = victim->end;
+      own.begin = victim->end - half;
+      victim->end = own.begin;
+    }
+    item = own.begin++;
+    return true;
+  }
+
+private:
+  struct Run {
+    size_t begin;
+    size_t end;
+  };
+
+  mutex mutex_;
+  vector<Run> runs_;
+};
+
 }
 
 class ParserImp
 {
 public:
-  ParserImp(const vector<UToken>& tokens, const ParserOption& option)
+  // nodes are allocated from arena, one of arenas
+  ParserImp(TokenBuffer& tokens, 
+            const ParserOption& option,
+            ParserArenas& arenas,
+            Arena& arena)
     : tokens_(tokens),
-      option_(option) { }
+      option_(option),
+      arenas_(arenas),
+      arena_(arena) { }
   AST process() {
-    AST root = TR(translationUnit);
-    cerr << root->toStr(option_.isCollapse) << endl;
+    AST root = parse();
+    if (option_.astFormat != ASTFormat::None) {
+      ASTWriter writer(cerr, tokens_);
+      if (option_.astFormat == ASTFormat::Binary) {
+        writer.writeBinary(root);
+      } else {
+        writer.writeText(root, option_.isCollapse);
+        writer.flush();
+        cerr << endl;
+      }
+    }
     return root;
   }
 
 private:
-  typedef vector<AST> VAST;
+  AST parse() {
+    if (option_.bodyMode == BodyMode::Deferred && !option_.isTrace) {
+      Arena::Mark mark = arena_.mark();
+      deferBodies_ = true;
+      AST root = TR(translationUnit);
+      if (root && parseDeferredBodies()) {
+        return root;
+      }
+      // start over, so that the failure is reported as an eager parse
+      // would report it
+      failed_ = false;
+      deferBodies_ = false;
+      deferredBodies_.clear();
+      index_ = 0;
+      brackets_.clear();
+      furthest_ = FurthestFailure();
+      arena_.rollback(mark);
+    }
+    AST root = TR(translationUnit);
+    if (!root) {
+      throw CompilerException(furthest_.message(failure_, tokens_));
+    }
+    return root;
+  }
+
+  // Parses every body deferredBody() stepped over, including those of
+  // attempts that were backtracked later: had any of them failed in place,
+  // the parse could have gone another way. Once all have parsed, the
+  // placeholders are given the children the eager parse would have given
+  // them; no placeholder changes while the bodies are parsed.
+  // False if a body fails.
+  bool parseDeferredBodies() {
+    deferBodies_ = false;
+    vector<pair<size_t, ASTNode*>> bodies(deferredBodies_.begin(),
+                                          deferredBodies_.end());
+    vector<AST> parsed(bodies.size());
+    size_t numWorkers = min<size_t>(option_.bodyThreads, bodies.size());
+    if (numWorkers <= 1) {
+      for (size_t i = 0; i < bodies.size(); ++i) {
+        if (!(parsed[i] = parseBody(bodies[i].first))) {
+          return false;
+        }
+      }
+    } else if (!parseBodiesInParallel(bodies, numWorkers, parsed)) {
+      return false;
+    }
+    for (size_t i = 0; i < bodies.size(); ++i) {
+      bodies[i].second->children = parsed[i]->children;
+    }
+    return true;
+  }
+
+  // Bodies only share the tokens, which nothing writes, so each worker
+  // parses with a ParserImp and an arena of its own, and stores what it
+  // parses in its own slots of parsed. A body that fails to parse stops
+  // the others early, and so does an exception; that of the earliest body
+  // any worker threw on is rethrown here. False if a body failed.
+  bool parseBodiesInParallel(const vector<pair<size_t, ASTNode*>>& bodies,
+                             size_t numWorkers,
+                             vector<AST>& parsed) {
+    WorkRuns runs(bodies.size(), numWorkers);
+    atomic<bool> failed { false };
+    vector<exception_ptr> errors(numWorkers);
+    // the body each worker failed on
+    vector<size_t> errorBodies(numWorkers);
+    while (arenas_.workers.size() < numWorkers) {
+      arenas_.workers.emplace_back();
+    }
+    auto work = [&](size_t worker) {
+      size_t i = bodies.size();
+      try {
+        ParserImp parser(tokens_, option_, arenas_, arenas_.workers[worker]);
+        while (!failed && runs.take(worker, i)) {
+          if (!(parsed[i] = parser.parseBody(bodies[i].first))) {
+            failed = true;
+          }
+        }
+      } catch (...) {
+        errors[worker] = current_exception();
+        errorBodies[worker] = i;
+        failed = true;
+      }
+    };
+    vector<thread> threads;
+    for (size_t worker = 1; worker < numWorkers; ++worker) {
+      threads.emplace_back(work, worker);
+    }
+    work(0);
+    for (auto& t : threads) {
+      t.join();
+    }
+    size_t first = numWorkers;
+    for (size_t worker = 0; worker < numWorkers; ++worker) {
+      if (errors[worker] &&
+          (first == numWorkers ||
+           errorBodies[worker] < errorBodies[first])) {
+        first = worker;
+      }
+    }
+    if (first < numWorkers) {
+      rethrow_exception(errors[first]);
+    }
+    return !failed;
+  }
+
+  AST parseBody(size_t begin) {
+    index_ = begin;
+    brackets_.clear();
+    return TR(compoundStatement);
+  }
+
+  // The children of the node a rule is building. They are collected on a
+  // stack shared by the whole parse, so no rule needs a vector of its own;
+  // get() copies them into the arena. Only the innermost live VAST may
+  // grow, which the recursive descent guarantees.
+  class VAST {
+  public:
+    explicit VAST(ParserImp* parser)
+      : stack_(parser->children_),
+        depth_(parser->childrenDepth_),
+        base_(stack_.size()) {
+      ++depth_;
+      level_ = depth_;
+    }
+    ~VAST() {
+      stack_.resize(base_);
+      --depth_;
+    }
+    VAST(const VAST&) = delete;
+    VAST& operator=(const VAST&) = delete;
+
+    void push_back(AST node) {
+      CHECK(level_ == depth_);
+      stack_.push_back(node);
+    }
+    size_t size() const {
+      return stack_.size() - base_;
+    }
+    const AST* data() const {
+      return stack_.data() + base_;
+    }
+    void clear() {
+      stack_.resize(base_);
+    }
+  private:
+    vector<AST>& stack_;
+    int& depth_;
+    int level_;
+    size_t base_;
+  };
 
   AST translationUnit() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(declaration);
     if (!isEof()) {
       BAD_EXPECT("<eof>");
@@ -121,17 +798,17 @@ private:
   }
 
   AST conditionalExpression() {
-    VAST c;
-    c.push_back(TR(logicalOrExpression));
+    VAST c(this);
+    PUSH(TR(logicalOrExpression));
     return finishConditionalExpression(c);
   }
 
   AST finishConditionalExpression(VAST& c) {
     if (isSimple(OP_QMARK)) {
-      c.push_back(expect(OP_QMARK));
-      c.push_back(TR(expression));
-      c.push_back(expect(OP_COLON));
-      c.push_back(TR(assignmentExpression));
+      PUSH(expect(OP_QMARK));
+      PUSH(TR(expression));
+      PUSH(expect(OP_COLON));
+      PUSH(TR(assignmentExpression));
     }
     return get(ASTType::ConditionalExpression, move(c));
   }
@@ -158,11 +835,11 @@ private:
     if (isSimple(KW_THROW)) {
       return TR(throwExpression);
     }
-    VAST c;
-    c.push_back(TR(logicalOrExpression));
+    VAST c(this);
+    PUSH(TR(logicalOrExpression));
     if (isAssignmentOperator()) {
       c.push_back(getAdv(ASTType::AssignmentOperator));
-      c.push_back(TR(initializerClause));
+      PUSH(TR(initializerClause));
       return get(ASTType::AssignmentExpression, move(c));
     } else {
       // the assignmentExpression is swallowed, which is fine
@@ -231,9 +908,9 @@ private:
     if (isSimple(OP_LSHIFT)) {
       return getAdv(ASTType::ShiftOperator);
     } else if (isSimple(OP_RSHIFT_1)) {
-      VAST c;
+      VAST c(this);
       c.push_back(getAdv());
-      c.push_back(expect(OP_RSHIFT_2));
+      PUSH(expect(OP_RSHIFT_2));
       return get(ASTType::ShiftOperator, move(c));
     } else {
       // this will make tracing less regular, but it's fine
@@ -267,14 +944,14 @@ private:
 
   AST castExpression() {
     if (isSimple(OP_LPAREN)) {
-      VAST c;
+      VAST c(this);
       // TODO: consider possible ways to optimize this
       // the reason we use backtrack here is for the cases how
       // (Class * Class) is handled
       AST castOp = BT(castOperator);
       if (castOp) {
-        c.push_back(move(castOp));
-        c.push_back(TR(castExpression));
+        PUSH(move(castOp));
+        PUSH(TR(castExpression));
         return get(ASTType::CastExpression, move(c));
       } // else failed to parse castOperator
         // try to parse unaryExpression instead
@@ -284,10 +961,10 @@ private:
   }
 
   AST typeIdInParen(ASTType type) {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(typeId));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(typeId));
+    PUSH(expect(OP_RPAREN));
     return get(type, move(c));
   }
 
@@ -296,34 +973,34 @@ private:
   }
 
   AST unaryExpression() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_SIZEOF)) {
       c.push_back(getAdv());
       AST node;
       // FIRST(unaryExpression) contains OP_LPAREN
-      if (node = BT(unaryExpression)) {
-        c.push_back(move(node));
+      if ((node = BT(unaryExpression))) {
+        PUSH(move(node));
       } else {
         if (isSimple(OP_LPAREN)) {
-          c.push_back(typeIdInParen(ASTType::TypeIdInParen));
+          PUSH(typeIdInParen(ASTType::TypeIdInParen));
         } else {
-          c.push_back(expect(OP_DOTS));
-          c.push_back(expect(OP_LPAREN));
-          c.push_back(expectIdentifier());
-          c.push_back(expect(OP_RPAREN));
+          PUSH(expect(OP_DOTS));
+          PUSH(expect(OP_LPAREN));
+          PUSH(expectIdentifier());
+          PUSH(expect(OP_RPAREN));
         }
       }
       return get(ASTType::UnaryExpression, move(c));
     } if (isSimple(KW_ALIGNOF)) {
       c.push_back(getAdv());
-      c.push_back(typeIdInParen(ASTType::TypeIdInParen));
+      PUSH(typeIdInParen(ASTType::TypeIdInParen));
       return get(ASTType::UnaryExpression, move(c));
     } else if (isUnaryOperator()) {
       // TODO: seems to be ambiguous with regard to 
       // id-expression (~class_name)
       // need to resolve this
       c.push_back(getAdv(ASTType::UnaryOperator));
-      c.push_back(TR(castExpression));
+      PUSH(TR(castExpression));
       return get(ASTType::UnaryExpression, move(c));
     } else if (isSimple(KW_NOEXCEPT)) {
       return TR(noExceptExpression);
@@ -337,38 +1014,38 @@ private:
   }
 
   AST postfixExpression() {
-    VAST c;
-    c.push_back(TR(postfixRoot));
+    VAST c(this);
+    PUSH(TR(postfixRoot));
     zeroOrMore(postfixSuffix);
     return get(ASTType::PostfixExpression, move(c));
   }
 
   AST postfixSuffix() {
-    VAST c;
+    VAST c(this);
     if (isSimple({OP_INC, OP_DEC})) {
       c.push_back(getAdv());
     } else if (isSimple(OP_LSQUARE)) {
       c.push_back(getAdv());
       if (isSimple(OP_LBRACE)) {
-        c.push_back(TR(bracedInitList));
+        PUSH(TR(bracedInitList));
       } else {
-        c.push_back(TR(expression));
+        PUSH(TR(expression));
       }
-      c.push_back(expect(OP_RSQUARE));
+      PUSH(expect(OP_RSQUARE));
     } else if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
       zeroOrOne(expressionList);
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_RPAREN));
     } else if (isSimple({OP_DOT, OP_ARROW})) {
       c.push_back(getAdv());
       AST node;
-      if (node = BT(pseudoDestructorName)) {
-        c.push_back(move(node));
+      if ((node = BT(pseudoDestructorName))) {
+        PUSH(move(node));
       } else {
         if (isSimple(KW_TEMPLATE)) {
           c.push_back(getAdv());
         }
-        c.push_back(TR(idExpression));
+        PUSH(TR(idExpression));
       }
     } else {
       BAD_EXPECT("postfix suffix");
@@ -384,22 +1061,22 @@ private:
   }
 
   AST pseudoDestructorNameA() {
-    VAST c;
+    VAST c(this);
     zeroOrOne(nestedNameSpecifier);
-    c.push_back(expect(OP_COMPL));
-    c.push_back(TR(typeName));
+    PUSH(expect(OP_COMPL));
+    PUSH(TR(typeName));
     return getAST(PseudoDestructorName);
   }
 
   AST pseudoDestructorNameB() {
-    VAST c;
-    c.push_back(expect(OP_COMPL));
-    c.push_back(TR(decltypeSpecifier));
+    VAST c(this);
+    PUSH(expect(OP_COMPL));
+    PUSH(TR(decltypeSpecifier));
     return getAST(PseudoDestructorName);
   }
 
   AST postfixRoot() {
-    VAST c;
+    VAST c(this);
     AST node;
     if (isSimple({KW_DYNAMIC_CAST, 
                   KW_STATIC_CAST, 
@@ -407,32 +1084,32 @@ private:
                   KW_REINTERPET_CAST, 
                   KW_CONST_CAST})) {
       c.push_back(getAdv());
-      c.push_back(expect(OP_LT_TEMPLATE));
-      c.push_back(TR(typeId));
-      c.push_back(TR(closeAngleBracket));
-      c.push_back(expect(OP_LPAREN));
-      c.push_back(TR(expression));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_LT_TEMPLATE));
+      PUSH(TR(typeId));
+      PUSH(TR(closeAngleBracket));
+      PUSH(expect(OP_LPAREN));
+      PUSH(TR(expression));
+      PUSH(expect(OP_RPAREN));
     } else if (isSimple(KW_TYPEID)) {
       c.push_back(getAdv());
-      c.push_back(expect(OP_LPAREN));
+      PUSH(expect(OP_LPAREN));
       (node = BT(expression)) ||
       (node = TR(typeId));
-      c.push_back(move(node));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(move(node));
+      PUSH(expect(OP_RPAREN));
     } else {
-      if (node = BT(primaryExpression)) {
-        c.push_back(move(node));
+      if ((node = BT(primaryExpression))) {
+        PUSH(move(node));
       } else {
         (node = BT(simpleTypeSpecifier)) ||
         (node = TR(typenameSpecifier));
-        c.push_back(move(node));
+        PUSH(move(node));
         if (isSimple(OP_LPAREN)) {
           c.push_back(getAdv());
           zeroOrOne(expressionList);
-          c.push_back(expect(OP_RPAREN));
+          PUSH(expect(OP_RPAREN));
         } else {
-          c.push_back(TR(bracedInitList));
+          PUSH(TR(bracedInitList));
         }
       }
     }
@@ -440,7 +1117,7 @@ private:
   }
 
   AST primaryExpression() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_TRUE)) {
       c.push_back(getAdv());
     } else if (isSimple(KW_FALSE)) {
@@ -453,22 +1130,22 @@ private:
       c.push_back(getAdv());
     } else if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
-      c.push_back(TR(expression));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(TR(expression));
+      PUSH(expect(OP_RPAREN));
     } else if (isSimple(OP_LSQUARE)) {
-      c.push_back(TR(lambdaExpression));
+      PUSH(TR(lambdaExpression));
     } else {
-      c.push_back(TR(idExpression));
+      PUSH(TR(idExpression));
     }
     return get(ASTType::PrimaryExpression, move(c));
   }
 
   AST noExceptExpression() {
-    VAST c;
-    c.push_back(expect(KW_NOEXCEPT));
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(expression));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(KW_NOEXCEPT));
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(expression));
+    PUSH(expect(OP_RPAREN));
     return get(ASTType::NoExceptExpression, move(c));
   }
 
@@ -490,7 +1167,7 @@ private:
    * =============
    */
   AST declaration() {
-    VAST c;
+    VAST c(this);
     AST node;
     (node = BT(blockDeclaration)) || 
     (node = BT(functionDefinition)) ||
@@ -501,12 +1178,12 @@ private:
     (node = BT(namespaceDefinition)) ||
     (node = BT(emptyDeclaration)) ||
     (node = TR(attributeDeclaration));
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::Declaration, move(c));
   }
 
   AST blockDeclaration() {
-    VAST c;
+    VAST c(this);
     AST node;
     (node = BT(simpleDeclaration)) ||
     (node = BT(asmDefinition)) ||
@@ -516,18 +1193,18 @@ private:
     (node = BT(staticAssertDeclaration)) ||
     (node = BT(aliasDeclaration)) ||
     (node = TR(opaqueEnumDeclaration));
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::BlockDeclaration, move(c));
   }
 
   AST simpleDeclaration() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(attributeSpecifier);
-    c.push_back(TR(declSpecifierSeq));
+    PUSH(TR(declSpecifierSeq));
     // TODO: initDeclaratorList can only be omitted when declaring a class
     // or enumeration
     zeroOrOne(initDeclaratorList);
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::SimpleDeclaration, move(c));
   }
 
@@ -538,122 +1215,122 @@ private:
   }
 
   AST initDeclarator() {
-    VAST c;
-    c.push_back(TR(declarator));
+    VAST c(this);
+    PUSH(TR(declarator));
     zeroOrOne(initializer);
     return get(ASTType::InitDeclarator, move(c));
   }
 
   AST initializer() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
-      c.push_back(TR(expressionList));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(TR(expressionList));
+      PUSH(expect(OP_RPAREN));
     } else {
-      c.push_back(TR(braceOrEqualInitializer));
+      PUSH(TR(braceOrEqualInitializer));
     }
     return get(ASTType::Initializer, move(c));
   }
 
   AST asmDefinition() {
-    VAST c;
-    c.push_back(expect(KW_ASM));
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(expectLiteral());
-    c.push_back(expect(OP_RPAREN));
-    c.push_back(expect(OP_SEMICOLON));
+    VAST c(this);
+    PUSH(expect(KW_ASM));
+    PUSH(expect(OP_LPAREN));
+    PUSH(expectLiteral());
+    PUSH(expect(OP_RPAREN));
+    PUSH(expect(OP_SEMICOLON));
     return getAST(AsmDefinition);
   }
 
   AST namespaceAliasDefinition() {
-    VAST c;
-    c.push_back(expect(KW_NAMESPACE));
-    c.push_back(expectIdentifier());
-    c.push_back(expect(OP_ASS));
-    c.push_back(TR(qualifiedNamespaceSpecifier));
-    c.push_back(expect(OP_SEMICOLON));
+    VAST c(this);
+    PUSH(expect(KW_NAMESPACE));
+    PUSH(expectIdentifier());
+    PUSH(expect(OP_ASS));
+    PUSH(TR(qualifiedNamespaceSpecifier));
+    PUSH(expect(OP_SEMICOLON));
     return getAST(NamespaceAliasDefinition);
   }
 
   AST qualifiedNamespaceSpecifier() {
-    VAST c;
+    VAST c(this);
     zeroOrOne(nestedNameSpecifier);
-    c.push_back(TR(namespaceName));
+    PUSH(TR(namespaceName));
     return getAST(QualifiedNamespaceSpecifier);
   }
 
   AST usingDirective() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(attributeSpecifier);
-    c.push_back(expect(KW_USING));
-    c.push_back(expect(KW_NAMESPACE));
+    PUSH(expect(KW_USING));
+    PUSH(expect(KW_NAMESPACE));
     zeroOrOne(nestedNameSpecifier);
-    c.push_back(expectIdentifier());
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expectIdentifier());
+    PUSH(expect(OP_SEMICOLON));
     return getAST(UsingDirective);
   }
 
   AST opaqueEnumDeclaration() {
-    VAST c;
-    c.push_back(TR(enumKey));
+    VAST c(this);
+    PUSH(TR(enumKey));
     zeroOrMore(attributeSpecifier);
-    c.push_back(expectIdentifier());
+    PUSH(expectIdentifier());
     zeroOrOne(enumBase);
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
     return getAST(OpaqueEnumDeclaration);
   }
 
   AST explicitInstantiation() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_EXTERN)) {
       c.push_back(getAdv());
     }
-    c.push_back(expect(KW_TEMPLATE));
-    c.push_back(TR(declaration));
+    PUSH(expect(KW_TEMPLATE));
+    PUSH(TR(declaration));
     return getAST(ExplicitInstantiation);
   }
 
   AST explicitSpecialization() {
-    VAST c;
-    c.push_back(expect(KW_TEMPLATE));
-    c.push_back(expect(OP_LT_TEMPLATE));
-    c.push_back(TR(closeAngleBracket));
-    c.push_back(TR(declaration));
+    VAST c(this);
+    PUSH(expect(KW_TEMPLATE));
+    PUSH(expect(OP_LT_TEMPLATE));
+    PUSH(TR(closeAngleBracket));
+    PUSH(TR(declaration));
     return getAST(ExplicitSpecialization);
   }
 
   AST linkageSpecification() {
-    VAST c;
-    c.push_back(expect(KW_EXTERN));
-    c.push_back(expectLiteral());
+    VAST c(this);
+    PUSH(expect(KW_EXTERN));
+    PUSH(expectLiteral());
     if (isSimple(OP_LBRACE)) {
       c.push_back(getAdv());
       zeroOrMore(declaration);
-      c.push_back(expect(OP_RBRACE));
+      PUSH(expect(OP_RBRACE));
     } else {
-      c.push_back(TR(declaration));
+      PUSH(TR(declaration));
     }
     return getAST(LinkageSpecification);
   }
 
   AST namespaceDefinition() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_INLINE)) {
       c.push_back(getAdv());
     }
-    c.push_back(expect(KW_NAMESPACE));
+    PUSH(expect(KW_NAMESPACE));
     if (isIdentifier()) {
       c.push_back(getAdv(ASTType::Identifier));
     }
-    c.push_back(expect(OP_LBRACE));
-    c.push_back(TR(namespaceBody));
-    c.push_back(expect(OP_RBRACE));
+    PUSH(expect(OP_LBRACE));
+    PUSH(TR(namespaceBody));
+    PUSH(expect(OP_RBRACE));
     return getAST(NamespaceDefinition);
   }
 
   AST namespaceBody() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(declaration);
     return getAST(NamespaceBody);
   }
@@ -666,78 +1343,78 @@ private:
   }
 
   AST attributeDeclaration() {
-    VAST c;
+    VAST c(this);
     oneOrMore(attributeSpecifier);
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
     return getAST(AttributeDeclaration);
   }
 
   AST declarator() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(ptrDeclarator)) {
-      c.push_back(move(node));
+    if ((node = BT(ptrDeclarator))) {
+      PUSH(move(node));
     } else {
-      c.push_back(TR(noptrDeclarator));
-      c.push_back(TR(trailingReturnType));
+      PUSH(TR(noptrDeclarator));
+      PUSH(TR(trailingReturnType));
     }
     return get(ASTType::Declarator, move(c));
   }
 
   AST ptrDeclarator() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(ptrOperator);
-    c.push_back(TR(noptrDeclarator));
+    PUSH(TR(noptrDeclarator));
     return get(ASTType::PtrDeclarator, move(c));
   }
 
   AST noptrDeclarator() {
-    VAST c;
-    c.push_back(TR(noptrDeclaratorRoot));
+    VAST c(this);
+    PUSH(TR(noptrDeclaratorRoot));
     zeroOrMore(noptrDeclaratorSuffix);
     return get(ASTType::NoptrDeclarator, move(c));
   }
 
   AST noptrDeclaratorRoot() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
-      c.push_back(TR(ptrDeclarator));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(TR(ptrDeclarator));
+      PUSH(expect(OP_RPAREN));
     } else {
-      c.push_back(TR(declaratorId));
+      PUSH(TR(declaratorId));
       zeroOrMore(attributeSpecifier);
     }
     return get(ASTType::NoptrDeclaratorRoot, move(c));
   }
 
   AST declaratorId() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
-    c.push_back(TR(idExpression));
+    PUSH(TR(idExpression));
     return getAST(DeclaratorId);
   }
 
   AST noptrDeclaratorSuffix() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LSQUARE)) {
       c.push_back(getAdv());
       zeroOrOne(constantExpression);
-      c.push_back(expect(OP_RSQUARE));
+      PUSH(expect(OP_RSQUARE));
       zeroOrMore(attributeSpecifier);
     } else {
-      c.push_back(TR(parametersAndQualifiers));
+      PUSH(TR(parametersAndQualifiers));
     }
     return get(ASTType::NoptrDeclaratorSuffix, move(c));
   }
 
   AST parametersAndQualifiers() {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(parameterDeclarationClause));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(parameterDeclarationClause));
+    PUSH(expect(OP_RPAREN));
     zeroOrMore(cvQualifier);
     zeroOrOne(refQualifier);
     zeroOrOne(exceptionSpecification);
@@ -754,15 +1431,15 @@ private:
   }
 
   AST parameterDeclarationClauseA() {
-    VAST c;
-    c.push_back(TR(parameterDeclarationList));
-    c.push_back(expect(OP_COMMA));
-    c.push_back(expect(OP_DOTS));
+    VAST c(this);
+    PUSH(TR(parameterDeclarationList));
+    PUSH(expect(OP_COMMA));
+    PUSH(expect(OP_DOTS));
     return getAST(ParameterDeclarationClause);
   }
 
   AST parameterDeclarationClauseB() {
-    VAST c;
+    VAST c(this);
     zeroOrOne(parameterDeclarationList);
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
@@ -773,39 +1450,39 @@ private:
   AST parameterDeclarationList() {
     // parameter-declaration-list's FOLLOW contains OP_COMMA
     // so need special handling
-    VAST c;
-    c.push_back(TR(parameterDeclaration));
+    VAST c(this);
+    PUSH(TR(parameterDeclaration));
     while (isSimple(OP_COMMA) && !nextIsSimple(OP_DOTS)) {
       c.push_back(getAdv());
-      c.push_back(TR(parameterDeclaration));
+      PUSH(TR(parameterDeclaration));
     }
     return getAST(ParameterDeclarationList);
   }
 
   AST parameterDeclaration() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(attributeSpecifier);
-    c.push_back(TR(declSpecifierSeq));
+    PUSH(TR(declSpecifierSeq));
     AST node;
     // TODO: do we need to disambuiguate here?
     (node = BT(parameterDeclarationSuffixA)) ||
     (node = BT(parameterDeclarationSuffixB));
-    c.push_back(move(node));
+    PUSH(move(node));
     return getAST(ParameterDeclaration);
   }
 
   AST parameterDeclarationSuffixA() {
-    VAST c;
-    c.push_back(TR(declarator));
+    VAST c(this);
+    PUSH(TR(declarator));
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
-      c.push_back(TR(initializerClause));
+      PUSH(TR(initializerClause));
     }
     return getAST(ParameterDeclarationSuffix);
   }
 
   AST parameterDeclarationSuffixB() {
-    VAST c;
+    VAST c(this);
     // TODO: if there is one we always take it; examine whether there are
     // cases we miss because of this
     // NOTE: in the entire implementation we'd assume this would not happen
@@ -814,7 +1491,7 @@ private:
     zeroOrOne(abstractDeclarator);
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
-      c.push_back(TR(initializerClause));
+      PUSH(TR(initializerClause));
     }
     return getAST(ParameterDeclarationSuffix);
   }
@@ -824,20 +1501,20 @@ private:
   }
 
   AST exceptionSpecification() {
-    VAST c;
+    VAST c(this);
     AST node;
     (node = BT(dynamicExceptionSpecification)) ||
     (node = TR(noexceptSpecification));
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::ExceptionSpecification, move(c));
   }
 
   AST dynamicExceptionSpecification() {
-    VAST c;
-    c.push_back(expect(KW_THROW));
-    c.push_back(expect(OP_LPAREN));
+    VAST c(this);
+    PUSH(expect(KW_THROW));
+    PUSH(expect(OP_LPAREN));
     zeroOrOne(typeIdList);
-    c.push_back(expect(OP_RPAREN));
+    PUSH(expect(OP_RPAREN));
     return get(ASTType::DynamicExceptionSpecification, move(c));
   }
 
@@ -848,8 +1525,8 @@ private:
   }
 
   AST typeIdDots() {
-    VAST c;
-    c.push_back(TR(typeId));
+    VAST c(this);
+    PUSH(TR(typeId));
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -857,22 +1534,22 @@ private:
   }
 
   AST typeId() {
-    VAST c;
-    c.push_back(TR(typeSpecifierSeq));
+    VAST c(this);
+    PUSH(TR(typeSpecifierSeq));
     zeroOrOne(abstractDeclarator);
     return get(ASTType::TypeId, move(c));
   }
 
   AST abstractDeclarator() {
-    VAST c;
+    VAST c(this);
     AST node;
     bool ok = (node = BT(ptrAbstractDeclarator)) ||
               (node = BT(abstractPackDeclarator));
     if (ok) {
-      c.push_back(move(node));
+      PUSH(move(node));
     } else {
       zeroOrOne(noptrAbstractDeclarator);
-      c.push_back(TR(trailingReturnType));
+      PUSH(TR(trailingReturnType));
     }
     return get(ASTType::AbstractDeclarator, move(c));
   }
@@ -887,64 +1564,64 @@ private:
   }
 
   AST ptrAbstractDeclaratorA() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(ptrOperator);
-    c.push_back(TR(noptrAbstractDeclarator));
+    PUSH(TR(noptrAbstractDeclarator));
     return get(ASTType::PtrAbstractDeclarator, move(c));
   }
 
   AST ptrAbstractDeclaratorB() {
-    VAST c;
+    VAST c(this);
     oneOrMore(ptrOperator);
     return get(ASTType::PtrAbstractDeclarator, move(c));
   }
 
   AST abstractPackDeclarator() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(ptrOperator);
-    c.push_back(TR(noptrAbstractDeclarator));
+    PUSH(TR(noptrAbstractDeclarator));
     return get(ASTType::AbstractPackDeclarator, move(c));
   }
 
   AST noptrAbstractDeclarator() {
-    VAST c;
-    c.push_back(expect(OP_DOTS));
+    VAST c(this);
+    PUSH(expect(OP_DOTS));
     zeroOrMore(noptrDeclaratorSuffix);
     return get(ASTType::NoptrAbstractDeclarator, move(c));
   }
 
   AST trailingReturnType() {
-    VAST c;
-    c.push_back(expect(OP_ARROW));
-    c.push_back(TR(trailingTypeSpecifierSeq));
+    VAST c(this);
+    PUSH(expect(OP_ARROW));
+    PUSH(TR(trailingTypeSpecifierSeq));
     zeroOrOne(abstractDeclarator);
     return get(ASTType::TrailingReturnType, move(c));
   }
 
   AST trailingTypeSpecifierSeq() {
-    VAST c;
+    VAST c(this);
     oneOrMore(trailingTypeSpecifier);
     zeroOrMore(attributeSpecifier);
     return getAST(TrailingTypeSpecifierSeq);
   }
 
   AST noexceptSpecification() {
-    VAST c;
-    c.push_back(expect(KW_NOEXCEPT));
+    VAST c(this);
+    PUSH(expect(KW_NOEXCEPT));
     zeroOrOne(noexceptSpecificationSuffix);
     return getAST(NoexceptSpecification);
   }
 
   AST noexceptSpecificationSuffix() {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(constantExpression));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(constantExpression));
+    PUSH(expect(OP_RPAREN));
     return getAST(NoexceptSpecificationSuffix);
   }
   
   AST exceptionDeclaration() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     } else {
@@ -953,8 +1630,8 @@ private:
       zeroOrMore(attributeSpecifier);
       // TODO: check whether this greedy treatment is sufficient
       AST node;
-      if (node = BT(declarator)) {
-        c.push_back(move(node));
+      if ((node = BT(declarator))) {
+        PUSH(move(node));
       } else {
         zeroOrOne(abstractDeclarator);
       }
@@ -963,23 +1640,23 @@ private:
   }
 
   AST conditionDeclaration() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(attributeSpecifier);
-    c.push_back(TR(declSpecifierSeq));
-    c.push_back(TR(declarator));
+    PUSH(TR(declSpecifierSeq));
+    PUSH(TR(declarator));
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
-      c.push_back(TR(initializerClause));
+      PUSH(TR(initializerClause));
     } else {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     }
     return getAST(ConditionDeclaration);
   }
 
   AST declarationStatement() {
     AST node = blockDeclaration();
-    VAST c;
-    c.push_back(move(node));
+    VAST c(this);
+    PUSH(move(node));
     return getAST(DeclarationStatement);
   }
 
@@ -989,30 +1666,30 @@ private:
    */
   AST idExpression() {
     // TODO: make the parsing more effective
-    VAST c;
+    VAST c(this);
     auto node = BT(qualifiedId);
     if (!node) {
       node = TR(unqualifiedId);
     }
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::IdExpression, move(c));
   }
 
   AST unqualifiedId() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_OPERATOR)) {
       // almost as efficient as checking FIRST, except for the exception catch
       AST node;
       (node = BT(literalOperatorId)) ||
       (node = BT(operatorFunctionId)) ||
       (node = TR(conversionFunctionId));
-      c.push_back(move(node));
+      PUSH(move(node));
     } else if (isSimple(OP_COMPL)) {
       c.push_back(getAdv());
       if (isSimple(KW_DECLTYPE)) {
-        c.push_back(TR(decltypeSpecifier));
+        PUSH(TR(decltypeSpecifier));
       } else {
-        c.push_back(TR(className));
+        PUSH(TR(className));
       }
     } else {
       // TODO: it's unclear to me how to disambiguate between
@@ -1021,19 +1698,22 @@ private:
       AST node;
       (node = BT(templateId)) ||
       (node = expectIdentifier());
-      c.push_back(move(node));
+      PUSH(move(node));
     }
     return get(ASTType::UnqualifiedId, move(c));
   }
 
   AST operatorFunctionId() {
-    VAST c;
-    c.push_back(expect(KW_OPERATOR));
+    VAST c(this);
+    PUSH(expect(KW_OPERATOR));
 
+    // a failure of the second token is left in failed_
     auto parseDouble = [this, &c](const vector<ETokenType>& m) -> bool {
       if (isSimple(m[0])) {
         c.push_back(getAdv());
-        c.push_back(expect(m[1]));
+        if (AST node = expect(m[1])) {
+          c.push_back(node);
+        }
         return true;
       } else {
         return false;
@@ -1093,40 +1773,43 @@ private:
         }
       }
     }
+    if (failed_) {
+      return nullptr;
+    }
 
     return get(ASTType::OperatorFunctionId, move(c));
   }
 
   AST literalOperatorId() {
-    VAST c;
-    c.push_back(expect(KW_OPERATOR));
+    VAST c(this);
+    PUSH(expect(KW_OPERATOR));
     if (!isEmptyStr()) {
       BAD_EXPECT("empty str");
     }
     c.push_back(getAdv());
-    c.push_back(expectIdentifier());
+    PUSH(expectIdentifier());
     return get(ASTType::LiteralOperatorId, move(c));
   }
 
   AST conversionFunctionId() {
-    VAST c;
-    c.push_back(expect(KW_OPERATOR));
-    c.push_back(TR(conversionTypeId));
+    VAST c(this);
+    PUSH(expect(KW_OPERATOR));
+    PUSH(TR(conversionTypeId));
     return get(ASTType::ConversionFunctionId, move(c));
   }
 
   AST conversionTypeId() {
-    VAST c;
-    c.push_back(TR(typeSpecifierSeq));
+    VAST c(this);
+    PUSH(TR(typeSpecifierSeq));
     AST node;
-    while (node = BT(ptrOperator)) {
-      c.push_back(move(node));
+    while ((node = BT(ptrOperator))) {
+      PUSH(move(node));
     }
     return get(ASTType::ConversionTypeId, move(c));
   }
 
   AST typeSpecifierSeq() {
-    VAST c;
+    VAST c(this);
     oneOrMore(typeSpecifier);
     zeroOrMore(attributeSpecifier);
     return get(ASTType::TypeSpecifierSeq, move(c));
@@ -1137,60 +1820,60 @@ private:
     (node = BT(enumSpecifier)) ||
     (node = BT(classSpecifier)) ||
     (node = TR(trailingTypeSpecifier));
-    VAST c;
-    c.push_back(move(node));
+    VAST c(this);
+    PUSH(move(node));
     return get(ASTType::TypeSpecifier, move(c));
   }
 
   AST enumSpecifier() {
-    VAST c;
-    c.push_back(TR(enumHead));
-    c.push_back(expect(OP_LBRACE));
+    VAST c(this);
+    PUSH(TR(enumHead));
+    PUSH(expect(OP_LBRACE));
     if (!isSimple(OP_RBRACE)) {
       // reduce non-empty enumerator-list
-      c.push_back(TR(enumeratorList));
+      PUSH(TR(enumeratorList));
       // optionally reduce an OP_COMMA
       if (isSimple(OP_COMMA)) {
         c.push_back(getAdv());
       }
     }
-    c.push_back(expect(OP_RBRACE));
+    PUSH(expect(OP_RBRACE));
     return get(ASTType::EnumSpecifier, move(c));
   }
 
   AST enumHead() {
-    VAST c;
-    c.push_back(TR(enumKey));
+    VAST c(this);
+    PUSH(TR(enumKey));
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
     // try to reduce a nested-name-specifier
-    if (node = BT(nestedNameSpecifier)) {
-      c.push_back(move(node));
+    if ((node = BT(nestedNameSpecifier))) {
+      PUSH(move(node));
       // must reduce an identifier
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     } else {
       if (isIdentifier()) {
         c.push_back(getAdv(ASTType::Identifier));
       }
     }
     if (isSimple(OP_COLON)) {
-      c.push_back(TR(enumBase));
+      PUSH(TR(enumBase));
     }
     return get(ASTType::EnumHead, move(c));
   }
 
   AST enumBase() {
-    VAST c;
-    c.push_back(expect(OP_COLON));
-    c.push_back(TR(typeSpecifierSeq));
+    VAST c(this);
+    PUSH(expect(OP_COLON));
+    PUSH(TR(typeSpecifierSeq));
     return get(ASTType::EnumBase, move(c));
   }
 
   AST enumKey() {
-    VAST c;
-    c.push_back(expect(KW_ENUM));
+    VAST c(this);
+    PUSH(expect(KW_ENUM));
     if (isSimple({ KW_CLASS, KW_STRUCT })) {
       c.push_back(getAdv());
     }
@@ -1204,50 +1887,50 @@ private:
   }
 
   AST enumeratorDefinition() {
-    VAST c;
-    c.push_back(expectIdentifier());
+    VAST c(this);
+    PUSH(expectIdentifier());
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
-      c.push_back(TR(constantExpression));
+      PUSH(TR(constantExpression));
     }
     return get(ASTType::EnumeratorDefinition, move(c));
   }
 
   AST nestedNameSpecifier() {
-    VAST c;
-    c.push_back(TR(nestedNameSpecifierRoot));
+    VAST c(this);
+    PUSH(TR(nestedNameSpecifierRoot));
     // We can do an optimization to check
     // isSimple(KW_TEMPLATE) || isIdentifier()
     // Since nestedNameSpecifier's FOLLOW also contains the two tokens
     // we need to be prepared to backtrack
     // So strive for simplicity for now
     AST node;
-    while (node = BT(nestedNameSpecifierSuffix)) {
-      c.push_back(move(node));
+    while ((node = BT(nestedNameSpecifierSuffix))) {
+      PUSH(move(node));
     }
     return get(ASTType::NestedNameSpecifier, move(c));
   }
 
   AST nestedNameSpecifierRoot() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_DECLTYPE)) {
-      c.push_back(TR(decltypeSpecifier));
+      PUSH(TR(decltypeSpecifier));
     } else {
       if (isSimple(OP_COLON2)) {
         c.push_back(getAdv());
       }
       if (isNamespaceName()) {
-        c.push_back(TR(namespaceName));
+        PUSH(TR(namespaceName));
       } else {
-        c.push_back(TR(typeName));
+        PUSH(TR(typeName));
       }
     }
-    c.push_back(expect(OP_COLON2));
+    PUSH(expect(OP_COLON2));
     return get(ASTType::NestedNameSpecifierRoot, move(c));
   }
 
   AST nestedNameSpecifierSuffix() {
-    VAST c;
+    VAST c(this);
     if (isIdentifier() && nextIsSimple(OP_COLON2)) {
       c.push_back(getAdv());
       c.push_back(getAdv());
@@ -1255,25 +1938,25 @@ private:
       if (isSimple(KW_TEMPLATE)) {
         c.push_back(getAdv());
       }
-      c.push_back(TR(simpleTemplateId));
-      c.push_back(expect(OP_COLON2));
+      PUSH(TR(simpleTemplateId));
+      PUSH(expect(OP_COLON2));
     }
     return get(ASTType::NestedNameSpecifierSuffix, move(c));
   }
 
   AST trailingTypeSpecifier() {
     AST node;
-    VAST c;
+    VAST c(this);
     (node = BT(simpleTypeSpecifier)) ||
     (node = BT(elaboratedTypeSpecifier)) ||
     (node = BT(typenameSpecifier)) ||
     (node = TR(cvQualifier));
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::TrailingTypeSpecifier, move(c));
   }
 
   AST simpleTypeSpecifier() {
-    VAST c;
+    VAST c(this);
     if (isSimple({
           KW_CHAR, KW_CHAR16_T, KW_CHAR32_T, KW_WCHAR_T, KW_BOOL, KW_SHORT,
           KW_INT, KW_LONG, KW_SIGNED, KW_UNSIGNED, KW_FLOAT, KW_DOUBLE,
@@ -1282,21 +1965,21 @@ private:
       c.push_back(getAdv());
     } else {
       AST node;
-      if (node = BT(decltypeSpecifier)) {
-        c.push_back(move(node));
+      if ((node = BT(decltypeSpecifier))) {
+        PUSH(move(node));
       } else {
         bool ok = false;
         // Note: this should be correct but a little tricky
-        if (node = BT(nestedNameSpecifier)) {
-          c.push_back(move(node));
+        if ((node = BT(nestedNameSpecifier))) {
+          PUSH(move(node));
           if (isSimple(KW_TEMPLATE)) {
             c.push_back(getAdv());
-            c.push_back(TR(simpleTemplateId));
+            PUSH(TR(simpleTemplateId));
             ok = true;
           }
         }
         if (!ok) {
-          c.push_back(TR(typeName));
+          PUSH(TR(typeName));
         }
       }
     }
@@ -1304,55 +1987,55 @@ private:
   }
 
   AST elaboratedTypeSpecifier() {
-    VAST c;
+    VAST c(this);
     AST node;
     if (isSimple(KW_ENUM)) {
       c.push_back(getAdv());
-      if (node = BT(nestedNameSpecifier)) {
-        c.push_back(move(node));
+      if ((node = BT(nestedNameSpecifier))) {
+        PUSH(move(node));
       }
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     } else {
-      c.push_back(TR(classKey));
-      if (node = BT(elaboratedTypeSpecifierA)) {
-        c.push_back(move(node));
+      PUSH(TR(classKey));
+      if ((node = BT(elaboratedTypeSpecifierA))) {
+        PUSH(move(node));
       } else {
-        c.push_back(TR(elaboratedTypeSpecifierB));
+        PUSH(TR(elaboratedTypeSpecifierB));
       }
     }
     return get(ASTType::ElaboratedTypeSpecifier, move(c));
   }
 
   AST elaboratedTypeSpecifierA() {
-    VAST c;
+    VAST c(this);
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
-    if (node = BT(nestedNameSpecifier)) {
-      c.push_back(move(node));
+    if ((node = BT(nestedNameSpecifier))) {
+      PUSH(move(node));
     }
-    c.push_back(expectIdentifier());
+    PUSH(expectIdentifier());
     return get(ASTType::ElaboratedTypeSpecifierA, move(c));
   }
 
   AST elaboratedTypeSpecifierB() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(nestedNameSpecifier)) {
-      c.push_back(move(node));
+    if ((node = BT(nestedNameSpecifier))) {
+      PUSH(move(node));
     }
     if (isSimple(KW_TEMPLATE)) {
       c.push_back(getAdv());
     }
-    c.push_back(TR(simpleTemplateId));
+    PUSH(TR(simpleTemplateId));
     return get(ASTType::ElaboratedTypeSpecifierB, move(c));
   }
 
   AST typenameSpecifier() {
-    VAST c;
-    c.push_back(expect(KW_TYPENAME));
-    c.push_back(TR(nestedNameSpecifier));
+    VAST c(this);
+    PUSH(expect(KW_TYPENAME));
+    PUSH(TR(nestedNameSpecifier));
     // TODO: this is ambiguous (and cannot be disambiguated by the first level
     // FOLLOW). For now take the identifier path but may later
     // turn out to be necessary to match the second first.
@@ -1362,7 +2045,7 @@ private:
       if (isSimple(KW_TEMPLATE)) {
         c.push_back(getAdv());
       }
-      c.push_back(TR(simpleTemplateId));
+      PUSH(TR(simpleTemplateId));
     }
     return get(ASTType::TypenameSpecifier, move(c));
   }
@@ -1375,31 +2058,31 @@ private:
   }
 
   AST attributeSpecifier() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LSQUARE)) {
-      c.push_back(expect(OP_LSQUARE));
-      c.push_back(expect(OP_LSQUARE));
-      c.push_back(TR(attributeList));
-      c.push_back(expect(OP_RSQUARE));
-      c.push_back(expect(OP_RSQUARE));
+      PUSH(expect(OP_LSQUARE));
+      PUSH(expect(OP_LSQUARE));
+      PUSH(TR(attributeList));
+      PUSH(expect(OP_RSQUARE));
+      PUSH(expect(OP_RSQUARE));
     } else {
-      c.push_back(TR(alignmentSpecifier));
+      PUSH(TR(alignmentSpecifier));
     }
     return get(ASTType::AttributeSpecifier, move(c));
   }
 
   AST alignmentSpecifier() {
-    VAST c;
-    c.push_back(expect(KW_ALIGNAS));
-    c.push_back(expect(OP_LPAREN));
+    VAST c(this);
+    PUSH(expect(KW_ALIGNAS));
+    PUSH(expect(OP_LPAREN));
     AST node;
     (node = BT(typeId)) ||
     (node = TR(assignmentExpression));
-    c.push_back(move(node));
+    PUSH(move(node));
     if (isSimple(OP_DOTS)) {
-      c.push_back(expect(OP_DOTS));
+      PUSH(expect(OP_DOTS));
     }
-    c.push_back(expect(OP_RPAREN));
+    PUSH(expect(OP_RPAREN));
     return getAST(AlignmentSpecifier);
   }
 
@@ -1410,10 +2093,10 @@ private:
   }
 
   AST attributePart() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(attribute)) {
-      c.push_back(move(node));
+    if ((node = BT(attribute))) {
+      PUSH(move(node));
       if (isSimple(OP_DOTS)) {
         // Since attribute-part's FOLLOW does not include OP_DOTS
         // we are forced to parse OP_DOTS
@@ -1424,38 +2107,38 @@ private:
   }
 
   AST attribute() {
-    VAST c;
-    c.push_back(TR(attributeToken));
+    VAST c(this);
+    PUSH(TR(attributeToken));
     AST node;
-    if (node = BT(attributeArgumentClause)) {
-      c.push_back(move(node));
+    if ((node = BT(attributeArgumentClause))) {
+      PUSH(move(node));
     }
     return get(ASTType::Attribute, move(c));
   }
 
   AST attributeArgumentClause() {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
     zeroOrMore(balancedToken);
-    c.push_back(expect(OP_RPAREN));
+    PUSH(expect(OP_RPAREN));
     return getAST(AttributeArgumentClause);
   }
 
   // TODO: this can be made more efficient
   AST balancedToken() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
       zeroOrMore(balancedToken);
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_RPAREN));
     } else if (isSimple(OP_LSQUARE)) {
       c.push_back(getAdv());
       zeroOrMore(balancedToken);
-      c.push_back(expect(OP_RSQUARE));
+      PUSH(expect(OP_RSQUARE));
     } else if (isSimple(OP_LBRACE)) {
       c.push_back(getAdv());
       zeroOrMore(balancedToken);
-      c.push_back(expect(OP_RBRACE));
+      PUSH(expect(OP_RBRACE));
     } else {
       if (isSimple({OP_RPAREN, OP_RSQUARE, OP_RBRACE}) ||
           isEof()) {
@@ -1467,23 +2150,23 @@ private:
   }
 
   AST attributeToken() {
-    VAST c;
+    VAST c(this);
     // should first take attribute-scoped-token because attribute-token's
     // FOLLOW does not include OP_COLON2
     AST node;
-    if (node = BT(attributeScopedToken)) {
-      c.push_back(move(node));
+    if ((node = BT(attributeScopedToken))) {
+      PUSH(move(node));
     } else {
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     }
     return get(ASTType::AttributeToken, move(c));
   }
 
   AST attributeScopedToken() {
-    VAST c;
-    c.push_back(TR(attributeNamespace));
-    c.push_back(expect(OP_COLON2));
-    c.push_back(expectIdentifier());
+    VAST c(this);
+    PUSH(TR(attributeNamespace));
+    PUSH(expect(OP_COLON2));
+    PUSH(expectIdentifier());
     return get(ASTType::AttributeScopedToken, move(c));
   }
 
@@ -1495,7 +2178,7 @@ private:
   }
 
   AST ptrOperator() {
-    VAST c;
+    VAST c(this);
     if (isSimple({OP_AMP, OP_LAND})) {
       c.push_back(getAdv()); 
       zeroOrMore(attributeSpecifier);
@@ -1503,8 +2186,8 @@ private:
       if (isSimple(OP_STAR)) {
         c.push_back(getAdv());
       } else {
-        c.push_back(TR(nestedNameSpecifier));
-        c.push_back(expect(OP_STAR));
+        PUSH(TR(nestedNameSpecifier));
+        PUSH(expect(OP_STAR));
       }
       zeroOrMore(attributeSpecifier);
       zeroOrMore(cvQualifier);
@@ -1517,33 +2200,33 @@ private:
    * =================
    */
   AST classSpecifier() {
-    VAST c;
-    c.push_back(TR(classHead));
-    c.push_back(expect(OP_LBRACE));
+    VAST c(this);
+    PUSH(TR(classHead));
+    PUSH(expect(OP_LBRACE));
     while (!isSimple(OP_RBRACE)) {
-      c.push_back(TR(memberSpecification));
+      PUSH(TR(memberSpecification));
     }
     c.push_back(getAdv());
     return get(ASTType::ClassSpecifier, move(c));
   }
 
   AST classHead() {
-    VAST c;
-    c.push_back(TR(classKey));
+    VAST c(this);
+    PUSH(TR(classKey));
     AST node;
     // TODO: we could have used FIRST as the FIRST set is very small
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
-    if (node = BT(classHeadName)) {
-      c.push_back(move(node));
+    if ((node = BT(classHeadName))) {
+      PUSH(move(node));
       // class-virt-specifier?
       if (isStFinal()) {
         c.push_back(getAdv(ASTType::StFinal));
       }
     }
     if (isSimple(OP_COLON)) {
-      c.push_back(TR(baseClause));
+      PUSH(TR(baseClause));
     }
     return get(ASTType::ClassHead, move(c));
   }
@@ -1556,16 +2239,16 @@ private:
   }
 
   AST classHeadName() {
-    VAST c;
+    VAST c(this);
     zeroOrOne(nestedNameSpecifier);
-    c.push_back(TR(className));
+    PUSH(TR(className));
     return get(ASTType::ClassHeadName, move(c));
   }
 
   AST baseClause() {
-    VAST c;
-    c.push_back(expect(OP_COLON));
-    c.push_back(TR(baseSpecifierList));
+    VAST c(this);
+    PUSH(expect(OP_COLON));
+    PUSH(TR(baseSpecifierList));
     return get(ASTType::BaseClause, move(c));
   }
 
@@ -1576,8 +2259,8 @@ private:
   }
 
   AST baseSpecifierDots() {
-    VAST c;
-    c.push_back(TR(baseSpecifer));
+    VAST c(this);
+    PUSH(TR(baseSpecifer));
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -1585,42 +2268,42 @@ private:
   }
 
   AST baseSpecifer() {
-    VAST c;
+    VAST c(this);
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
     if (isSimple(KW_VIRTUAL)) {
       c.push_back(getAdv());
-      if (node = BT(accessSpecifier)) {
-        c.push_back(move(node));
+      if ((node = BT(accessSpecifier))) {
+        PUSH(move(node));
       }
-    } else if (node = BT(accessSpecifier)) {
-      c.push_back(move(node));
+    } else if ((node = BT(accessSpecifier))) {
+      PUSH(move(node));
       if (isSimple(KW_VIRTUAL)) {
         c.push_back(getAdv());
       }
     }
-    c.push_back(TR(baseTypeSpecifier));
+    PUSH(TR(baseTypeSpecifier));
     return get(ASTType::BaseSpecifer, move(c));
   }
 
   AST baseTypeSpecifier() {
-    VAST c;
-    c.push_back(TR(classOrDecltype));
+    VAST c(this);
+    PUSH(TR(classOrDecltype));
     return get(ASTType::BaseTypeSpecifier, move(c));
   }
 
   AST classOrDecltype() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(decltypeSpecifier)) {
-      c.push_back(move(node));
+    if ((node = BT(decltypeSpecifier))) {
+      PUSH(move(node));
     } else {
-      if (node = BT(nestedNameSpecifier)) {
-        c.push_back(move(node));
+      if ((node = BT(nestedNameSpecifier))) {
+        PUSH(move(node));
       }
-      c.push_back(TR(className));
+      PUSH(TR(className));
     }
     return get(ASTType::ClassOrDecltype, move(c));
   }
@@ -1633,61 +2316,61 @@ private:
   }
 
   AST memberSpecification() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(accessSpecifier)) {
-      c.push_back(move(node));
-      c.push_back(expect(OP_COLON));
+    if ((node = BT(accessSpecifier))) {
+      PUSH(move(node));
+      PUSH(expect(OP_COLON));
     } else {
-      c.push_back(TR(memberDeclaration));
+      PUSH(TR(memberDeclaration));
     }
     return get(ASTType::MemberSpecification, move(c));
   }
 
   AST memberDeclaration() {
-    VAST c;
+    VAST c(this);
     AST node;
     bool ok = (node = BT(usingDeclaration)) ||
               (node = BT(staticAssertDeclaration)) ||
               (node = BT(templateDeclaration)) ||
               (node = BT(aliasDeclaration));
     if (ok) {
-      c.push_back(move(node));
+      PUSH(move(node));
     } else {
-      if (node = BT(functionDefinition)) {
-        c.push_back(move(node));
+      if ((node = BT(functionDefinition))) {
+        PUSH(move(node));
         if (isSimple(OP_SEMICOLON)) {
           c.push_back(getAdv());
         }
       } else {
-        while (node = BT(attributeSpecifier)) {
-          c.push_back(move(node));
+        while ((node = BT(attributeSpecifier))) {
+          PUSH(move(node));
         } 
-        c.push_back(TR(declSpecifierSeq));
-        if (node = BT(memberDeclaratorList)) {
-          c.push_back(move(node));
+        PUSH(TR(declSpecifierSeq));
+        if ((node = BT(memberDeclaratorList))) {
+          PUSH(move(node));
         }
-        c.push_back(expect(OP_SEMICOLON));
+        PUSH(expect(OP_SEMICOLON));
       } 
     }
     return get(ASTType::MemberDeclaration, move(c));
   }
 
   AST declSpecifierSeq() {
-    VAST c;
-    c.push_back(TR(declSpecifier));
+    VAST c(this);
+    PUSH(TR(declSpecifier));
     AST node;
-    while (node = BT(declSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(declSpecifier))) {
+      PUSH(move(node));
     }
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
     return get(ASTType::DeclSpecifierSeq, move(c));
   }
 
   AST declSpecifier() {
-    VAST c;
+    VAST c(this);
     if (isSimple({KW_FRIEND, KW_TYPEDEF, KW_CONSTEXPR})) {
       c.push_back(getAdv());
     } else {
@@ -1695,7 +2378,7 @@ private:
       (node = BT(storageClassSpecifier)) ||
       (node = BT(typeSpecifier)) ||
       (node = TR(functionSpecifier));
-      c.push_back(move(node));
+      PUSH(move(node));
     }
     return get(ASTType::DeclSpecifier, move(c));
   }
@@ -1720,90 +2403,113 @@ private:
   }
 
   AST memberDeclarator() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(declarator)) {
-      c.push_back(move(node));
+    if ((node = BT(declarator))) {
+      PUSH(move(node));
       // TODO: use FOLLOW set to prune the search
-      if (node = BT(braceOrEqualInitializer)) {
-        c.push_back(move(node));
+      if ((node = BT(braceOrEqualInitializer))) {
+        PUSH(move(node));
       } else {
-        while (node = BT(virtSpecifier)) {
-          c.push_back(move(node));
+        while ((node = BT(virtSpecifier))) {
+          PUSH(move(node));
         }
-        if (node = BT(pureSpecifier)) {
-          c.push_back(move(node));
+        if ((node = BT(pureSpecifier))) {
+          PUSH(move(node));
         }
       }
     } else {
       if (isIdentifier()) {
         c.push_back(getAdv(ASTType::Identifier));
       }
-      while (node = attributeSpecifier()) {
-        c.push_back(move(node));
+      while ((node = attributeSpecifier())) {
+        PUSH(move(node));
       }
-      c.push_back(expect(OP_COLON));
-      c.push_back(TR(constantExpression));
+      PUSH(expect(OP_COLON));
+      PUSH(TR(constantExpression));
     }
     return get(ASTType::MemberDeclarator, move(c));
   }
 
   AST braceOrEqualInitializer() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
-      c.push_back(TR(initializerClause));
+      PUSH(TR(initializerClause));
     } else {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     }
     return get(ASTType::BraceOrEqualInitializer, move(c));
   }
 
   AST pureSpecifier() {
-    VAST c;
-    c.push_back(expect(OP_ASS));
-    c.push_back(expectZero());
+    VAST c(this);
+    PUSH(expect(OP_ASS));
+    PUSH(expectZero());
     return get(ASTType::PureSpecifier, move(c));
   }
 
   AST functionDefinition() {
-    VAST c;
+    VAST c(this);
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
-    c.push_back(TR(declSpecifierSeq));
-    c.push_back(TR(declarator));
-    if (node = BT(virtSpecifier)) {
-      c.push_back(move(node));
+    PUSH(TR(declSpecifierSeq));
+    PUSH(TR(declarator));
+    if ((node = BT(virtSpecifier))) {
+      PUSH(move(node));
     }
-    c.push_back(TR(functionBody));
+    PUSH(TR(functionBody));
     return get(ASTType::FunctionDefinition, move(c));
   }
 
   AST functionBody() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_ASS)) {
       c.push_back(getAdv());
       if (!isSimple({KW_DEFAULT, KW_DELETE})) {
         BAD_EXPECT("default / delete");
       }
-      c.push_back(expect(OP_SEMICOLON));
+      PUSH(expect(OP_SEMICOLON));
     } else if (isSimple(KW_TRY)) {
-      c.push_back(TR(functionTryBlock));
+      PUSH(TR(functionTryBlock));
     } else {
       if (isSimple(OP_COLON)) {
-        c.push_back(TR(ctorInitializer));
+        PUSH(TR(ctorInitializer));
       }
-      c.push_back(TR(compoundStatement));
+      PUSH(deferBodies_ ? deferredBody() : TR(compoundStatement));
     }
     return get(ASTType::FunctionBody, move(c));
   }
 
+  // Steps over a compound statement, leaving an empty one to be filled in
+  // by parseDeferredBodies. The open brackets are left as they are, as
+  // parsing the statement would have left them.
+  AST deferredBody() {
+    if (!isSimple(OP_LBRACE)) {
+      BAD_EXPECT("{");
+    }
+    size_t end = matchBrace(tokens_, index_);
+    if (end == string::npos) {
+      BAD_EXPECT("}");
+    }
+    // backtracking may step over the same body more than once
+    ASTNode*& body = deferredBodies_[index_];
+    if (!body) {
+      TimeReport::count(TimeReport::DeferredBodies);
+      body = arenas_.bodies.make<ASTNode>(ASTType::CompoundStatement, 
+                                      nullptr, 
+                                      0);
+    }
+    index_ = end + 1;
+    return body;
+  }
+
   AST ctorInitializer() {
-    VAST c;
-    c.push_back(expect(OP_COLON));
-    c.push_back(TR(memInitialierList));
+    VAST c(this);
+    PUSH(expect(OP_COLON));
+    PUSH(TR(memInitialierList));
     return get(ASTType::CtorInitializer, move(c));
   }
 
@@ -1815,8 +2521,8 @@ private:
   }
 
   AST memInitialierDots() {
-    VAST c;
-    c.push_back(TR(memInitialier));
+    VAST c(this);
+    PUSH(TR(memInitialier));
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -1824,31 +2530,31 @@ private:
   }
 
   AST memInitialier() {
-    VAST c;
-    c.push_back(TR(memInitialierId));
+    VAST c(this);
+    PUSH(TR(memInitialierId));
     if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
       AST node;
-      if (node = BT(expressionList)) {
-        c.push_back(move(node));
+      if ((node = BT(expressionList))) {
+        PUSH(move(node));
       }
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_RPAREN));
     } else {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     }
     return get(ASTType::MemInitialier, move(c));
   }
 
   AST memInitialierId() {
-    VAST c;
+    VAST c(this);
     AST node;  
     // first try parsing class-or-decltype, even though both FIRST contain
     // identifier
     // - let's try this scheme for now
-    if (node = BT(classOrDecltype)) {
-      c.push_back(move(node));
+    if ((node = BT(classOrDecltype))) {
+      PUSH(move(node));
     } else {
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     }
     return get(ASTType::MemInitialierId, move(c));
   }
@@ -1858,37 +2564,37 @@ private:
   }
 
   AST compoundStatement() {
-    VAST c;
-    c.push_back(expect(OP_LBRACE));
+    VAST c(this);
+    PUSH(expect(OP_LBRACE));
     while (!isSimple(OP_RBRACE)) {
-      c.push_back(TR(statement));
+      PUSH(TR(statement));
     }
     c.push_back(getAdv());
     return get(ASTType::CompoundStatement, move(c));
   }
 
   AST functionTryBlock() {
-    VAST c;
-    c.push_back(expect(KW_TRY));
+    VAST c(this);
+    PUSH(expect(KW_TRY));
     AST node;
-    if (node = BT(ctorInitializer)) {
-      c.push_back(move(node));
+    if ((node = BT(ctorInitializer))) {
+      PUSH(move(node));
     }
-    c.push_back(TR(compoundStatement));
-    c.push_back(TR(handler));
+    PUSH(TR(compoundStatement));
+    PUSH(TR(handler));
     while (isSimple(KW_CATCH)) {
-      c.push_back(TR(handler));
+      PUSH(TR(handler));
     }
     return get(ASTType::FunctionTryBlock, move(c));
   }
 
   AST handler() {
-    VAST c;
-    c.push_back(expect(KW_CATCH));
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(exceptionDeclaration));
-    c.push_back(expect(OP_RPAREN));
-    c.push_back(TR(compoundStatement));
+    VAST c(this);
+    PUSH(expect(KW_CATCH));
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(exceptionDeclaration));
+    PUSH(expect(OP_RPAREN));
+    PUSH(TR(compoundStatement));
     return get(ASTType::Handler, move(c));
   }
 
@@ -1900,40 +2606,40 @@ private:
   }
 
   AST usingDeclaration() {
-    VAST c;
-    c.push_back(expect(KW_USING));
+    VAST c(this);
+    PUSH(expect(KW_USING));
     if (isSimple(OP_COLON2)) {
       c.push_back(getAdv());
     } else {
       if (isSimple(KW_TYPENAME)) {
         c.push_back(getAdv());
       }
-      c.push_back(TR(nestedNameSpecifier));
+      PUSH(TR(nestedNameSpecifier));
     }
-    c.push_back(TR(unqualifiedId));
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(TR(unqualifiedId));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::UsingDeclaration, move(c));
   }
 
   AST staticAssertDeclaration() {
-    VAST c;
-    c.push_back(expect(KW_STATIC_ASSERT));
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(constantExpression));
-    c.push_back(expect(OP_COMMA));
-    c.push_back(expectLiteral());
-    c.push_back(expect(OP_RPAREN));
-    c.push_back(expect(OP_SEMICOLON));
+    VAST c(this);
+    PUSH(expect(KW_STATIC_ASSERT));
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(constantExpression));
+    PUSH(expect(OP_COMMA));
+    PUSH(expectLiteral());
+    PUSH(expect(OP_RPAREN));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::StaticAssertDeclaration, move(c));
   }
 
   AST templateDeclaration() {
-    VAST c;
-    c.push_back(expect(KW_TEMPLATE));
-    c.push_back(expect(OP_LT_TEMPLATE));
-    c.push_back(TR(templateParameterList));
-    c.push_back(TR(closeAngleBracket));
-    c.push_back(TR(declaration));
+    VAST c(this);
+    PUSH(expect(KW_TEMPLATE));
+    PUSH(expect(OP_LT_TEMPLATE));
+    PUSH(TR(templateParameterList));
+    PUSH(TR(closeAngleBracket));
+    PUSH(TR(declaration));
     return get(ASTType::TemplateDeclaration, move(c));
   }
 
@@ -1944,38 +2650,38 @@ private:
   }
 
   AST templateParameter() {
-    VAST c;
+    VAST c(this);
     AST node;
     (node = BT(typeParameter)) ||
     (node = TR(parameterDeclaration));
-    c.push_back(move(node));
+    PUSH(move(node));
     return getAST(TemplateParameter);
   }
 
   AST typeParameter() {
-    VAST c;
+    VAST c(this);
     if (isSimple({KW_CLASS, KW_TYPENAME})) {
       c.push_back(getAdv());
       AST node;
       (node = BT(typeParameterSuffixA)) ||
       (node = TR(typeParameterSuffixB));
-      c.push_back(move(node));
+      PUSH(move(node));
     } else {
-      c.push_back(expect(KW_TEMPLATE));
-      c.push_back(expect(OP_LT_TEMPLATE));
-      c.push_back(TR(templateParameterList));
-      c.push_back(closeAngleBracket());
-      c.push_back(expect(KW_CLASS));
+      PUSH(expect(KW_TEMPLATE));
+      PUSH(expect(OP_LT_TEMPLATE));
+      PUSH(TR(templateParameterList));
+      PUSH(closeAngleBracket());
+      PUSH(expect(KW_CLASS));
       AST node;
       (node = BT(typeParameterSuffixA)) ||
       (node = TR(typeParameterSuffixC));
-      c.push_back(move(node));
+      PUSH(move(node));
     }
     return getAST(TypeParameter);
   }
 
   AST typeParameterSuffixA() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -1986,36 +2692,36 @@ private:
   }
 
   AST typeParameterSuffixB() {
-    VAST c;
+    VAST c(this);
     if (isIdentifier()) {
       c.push_back(getAdv(ASTType::Identifier));
     }
-    c.push_back(expect(OP_ASS));
-    c.push_back(TR(typeId));
+    PUSH(expect(OP_ASS));
+    PUSH(TR(typeId));
     return getAST(TypeParameterSuffix);
   }
 
   AST typeParameterSuffixC() {
-    VAST c;
+    VAST c(this);
     if (isIdentifier()) {
       c.push_back(getAdv(ASTType::Identifier));
     }
-    c.push_back(expect(OP_ASS));
-    c.push_back(TR(idExpression));
+    PUSH(expect(OP_ASS));
+    PUSH(TR(idExpression));
     return getAST(TypeParameterSuffix);
   }
 
   AST aliasDeclaration() {
-    VAST c;
-    c.push_back(expect(KW_USING));
-    c.push_back(expectIdentifier());
+    VAST c(this);
+    PUSH(expect(KW_USING));
+    PUSH(expectIdentifier());
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
-    c.push_back(expect(OP_ASS));
-    c.push_back(TR(typeId));
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_ASS));
+    PUSH(TR(typeId));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::AliasDeclaration, move(c));
   } 
 
@@ -2024,18 +2730,18 @@ private:
    * =================
    */
   AST statement() {
-    VAST c;
+    VAST c(this);
     AST node;
     bool ok = (node = BT(labeledStatement)) ||
               // The disambiguation rule says we should try parsing
               // declaration-statement first
               (node = BT(declarationStatement));
     if (ok) { 
-      c.push_back(move(node));
+      PUSH(move(node));
     } else {
       // TODO: this is a common pattern
-      while (node = BT(attributeSpecifier)) {
-        c.push_back(move(node));
+      while ((node = BT(attributeSpecifier))) {
+        PUSH(move(node));
       }
       (node = BT(expressionStatement)) ||
       (node = BT(compoundStatement)) ||
@@ -2043,198 +2749,198 @@ private:
       (node = BT(iterationStatement)) ||
       (node = BT(jumpStatement)) ||
       (node = TR(tryBlock));
-      c.push_back(move(node));
+      PUSH(move(node));
     }
     return get(ASTType::Statement, move(c));
   }
 
   AST labeledStatement() {
-    VAST c;
+    VAST c(this);
     AST node;
-    while (node = BT(attributeSpecifier)) {
-      c.push_back(move(node));
+    while ((node = BT(attributeSpecifier))) {
+      PUSH(move(node));
     }
     if (isSimple(KW_CASE)) {
       c.push_back(getAdv());
-      c.push_back(TR(constantExpression));
+      PUSH(TR(constantExpression));
     } else if (isSimple(KW_DEFAULT)) {
       c.push_back(getAdv());
     } else {
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     }
-    c.push_back(expect(OP_COLON));
-    c.push_back(TR(statement));
+    PUSH(expect(OP_COLON));
+    PUSH(TR(statement));
     return get(ASTType::LabeledStatement, move(c));
   }
 
   AST expressionStatement() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(expression)) {
-      c.push_back(move(node));
+    if ((node = BT(expression))) {
+      PUSH(move(node));
     }
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::ExpressionStatement, move(c));
   }
 
   AST selectionStatement() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_SWITCH)) {
       c.push_back(getAdv());
-      c.push_back(expect(OP_LPAREN));
-      c.push_back(TR(condition));
-      c.push_back(expect(OP_RPAREN));
-      c.push_back(TR(statement));
+      PUSH(expect(OP_LPAREN));
+      PUSH(TR(condition));
+      PUSH(expect(OP_RPAREN));
+      PUSH(TR(statement));
     } else {
-      c.push_back(expect(KW_IF));
-      c.push_back(expect(OP_LPAREN));
-      c.push_back(TR(condition));
-      c.push_back(expect(OP_RPAREN));
-      c.push_back(TR(statement));
+      PUSH(expect(KW_IF));
+      PUSH(expect(OP_LPAREN));
+      PUSH(TR(condition));
+      PUSH(expect(OP_RPAREN));
+      PUSH(TR(statement));
       // disambiguation rule for "dangling else"
       if (isSimple(KW_ELSE)) {
         c.push_back(getAdv());
-        c.push_back(TR(statement));
+        PUSH(TR(statement));
       }
     }
     return get(ASTType::SelectionStatement, move(c));
   }
 
   AST iterationStatement() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_WHILE)) {
       c.push_back(getAdv());
-      c.push_back(expect(OP_LPAREN));
-      c.push_back(TR(condition));
-      c.push_back(expect(OP_RPAREN));
-      c.push_back(TR(statement));
+      PUSH(expect(OP_LPAREN));
+      PUSH(TR(condition));
+      PUSH(expect(OP_RPAREN));
+      PUSH(TR(statement));
     } else if (isSimple(KW_DO)) {
       c.push_back(getAdv());
-      c.push_back(TR(statement));
-      c.push_back(expect(KW_WHILE));
-      c.push_back(expect(OP_LPAREN));
-      c.push_back(TR(condition));
-      c.push_back(expect(OP_RPAREN));
-      c.push_back(expect(OP_SEMICOLON));
+      PUSH(TR(statement));
+      PUSH(expect(KW_WHILE));
+      PUSH(expect(OP_LPAREN));
+      PUSH(TR(condition));
+      PUSH(expect(OP_RPAREN));
+      PUSH(expect(OP_SEMICOLON));
     } else {
-      c.push_back(expect(KW_FOR));
-      c.push_back(expect(OP_LPAREN));
+      PUSH(expect(KW_FOR));
+      PUSH(expect(OP_LPAREN));
       AST node;
-      if (node = BT(forTraditionalSpecifier)) {
-        c.push_back(move(node));
+      if ((node = BT(forTraditionalSpecifier))) {
+        PUSH(move(node));
       } else {
-        c.push_back(TR(forRangeBasedSpecifier));
+        PUSH(TR(forRangeBasedSpecifier));
       }
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_RPAREN));
 
-      c.push_back(TR(statement));
+      PUSH(TR(statement));
     }
     return get(ASTType::IterationStatement, move(c));
   }
 
   AST forTraditionalSpecifier() {
-    VAST c;
-    c.push_back(TR(forInitStatement));
+    VAST c(this);
+    PUSH(TR(forInitStatement));
 
     if (!isSimple(OP_SEMICOLON)) {
-      c.push_back(TR(condition));
+      PUSH(TR(condition));
     }
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
 
     if (!isSimple(OP_RPAREN)) {
-      c.push_back(TR(expression));
+      PUSH(TR(expression));
     }
     return get(ASTType::ForTraditionalSpecifier, move(c));
   }
 
   AST forRangeBasedSpecifier() {
-    VAST c;
-    c.push_back(TR(forRangeDeclaration));
-    c.push_back(expect(OP_COLON));
-    c.push_back(TR(forRangeInitializer));
+    VAST c(this);
+    PUSH(TR(forRangeDeclaration));
+    PUSH(expect(OP_COLON));
+    PUSH(TR(forRangeInitializer));
     return get(ASTType::ForRangeBasedSpecifier, move(c));
   }
 
   AST forInitStatement() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(expressionStatement)) {
-      c.push_back(move(node));
+    if ((node = BT(expressionStatement))) {
+      PUSH(move(node));
     } else {
-      c.push_back(TR(simpleDeclaration));
+      PUSH(TR(simpleDeclaration));
     }
     return get(ASTType::ForInitStatement, move(c));
   }
 
   // TODO; this seems redudant to something
   AST forRangeDeclaration() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(attributeSpecifier);
-    c.push_back(TR(declSpecifierSeq));
-    c.push_back(TR(declarator));
+    PUSH(TR(declSpecifierSeq));
+    PUSH(TR(declarator));
     return get(ASTType::ForRangeDeclaration, move(c));
   }
 
   AST forRangeInitializer() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LBRACE)) {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     } else {
-      c.push_back(TR(expression));
+      PUSH(TR(expression));
     }
     return get(ASTType::ForRangeInitializer, move(c));
   }
 
   AST jumpStatement() {
-    VAST c;
+    VAST c(this);
     if (isSimple({KW_BREAK, KW_CONTINUE})) {
       c.push_back(getAdv());
     } else if (isSimple(KW_RETURN)) {
       c.push_back(getAdv());
       if (isSimple(OP_LBRACE)) {
-        c.push_back(TR(bracedInitList));
+        PUSH(TR(bracedInitList));
       } else if (!isSimple(OP_SEMICOLON)) {
-        c.push_back(TR(expression));
+        PUSH(TR(expression));
       }
     } else {
-      c.push_back(expect(KW_GOTO));
-      c.push_back(expectIdentifier());
+      PUSH(expect(KW_GOTO));
+      PUSH(expectIdentifier());
     }
-    c.push_back(expect(OP_SEMICOLON));
+    PUSH(expect(OP_SEMICOLON));
     return get(ASTType::JumpStatement, move(c));
   }
 
   AST tryBlock() {
-    VAST c;
-    c.push_back(expect(KW_TRY));
-    c.push_back(TR(compoundStatement));
+    VAST c(this);
+    PUSH(expect(KW_TRY));
+    PUSH(TR(compoundStatement));
     // TODO: repeated pattern
-    c.push_back(TR(handler));
+    PUSH(TR(handler));
     while (isSimple(KW_CATCH)) {
-      c.push_back(TR(handler));
+      PUSH(TR(handler));
     }
     return get(ASTType::TryBlock, move(c));
   }
 
   AST condition() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(conditionDeclaration)) {
-      c.push_back(move(node));
+    if ((node = BT(conditionDeclaration))) {
+      PUSH(move(node));
     } else {
-      c.push_back(TR(expression));
+      PUSH(TR(expression));
     }
     return get(ASTType::Condition, move(c));
   }
 
   AST className() { 
-    VAST c;
+    VAST c(this);
     if (!isClassName()) {
       BAD_EXPECT("class name"); 
     }
     AST node;
-    if (node = BT(simpleTemplateId)) {
-      c.push_back(move(node)); 
+    if ((node = BT(simpleTemplateId))) {
+      PUSH(move(node));
     } else {
       c.push_back(getAdv(ASTType::Identifier));
     }
@@ -2243,13 +2949,13 @@ private:
 
   AST typeName() {
     // An important NT - give it a level
-    VAST c;
+    VAST c(this);
     AST node;
     (node = BT(className)) ||
     (node = BT(enumName)) ||
     (node = BT(typedefName)) ||
     (node = TR(simpleTemplateId));
-    c.push_back(move(node));
+    PUSH(move(node));
     return get(ASTType::TypeName, move(c));
   }
 
@@ -2276,11 +2982,11 @@ private:
   }
 
   AST simpleTemplateId() {
-    VAST c;
-    c.push_back(expectTemplateName());
-    c.push_back(expect(OP_LT_TEMPLATE));
+    VAST c(this);
+    PUSH(expectTemplateName());
+    PUSH(expect(OP_LT_TEMPLATE));
     zeroOrOne(templateArgumentList);
-    c.push_back(TR(closeAngleBracket));
+    PUSH(TR(closeAngleBracket));
     return get(ASTType::SimpleTemplateId, move(c));
   }
 
@@ -2291,8 +2997,8 @@ private:
   }
 
   AST templateArgumentDots() {
-    VAST c;
-    c.push_back(templateArgument());
+    VAST c(this);
+    PUSH(templateArgument());
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -2300,16 +3006,16 @@ private:
   }
 
   AST templateArgument() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_DECLTYPE) || isSimple(KW_OPERATOR) || isSimple(OP_COLON2) ||
         isSimple(OP_COMPL) || isIdentifier()) {
-      c.push_back(TR(idExpression));
+      PUSH(TR(idExpression));
     } else {
       // Implement FIRST here
       AST node;
       (node = BT(constantExpression)) ||
       (node = TR(typeId));
-      c.push_back(move(node));
+      PUSH(move(node));
     }
     return get(ASTType::TemplateArgument, move(c));
   }
@@ -2325,7 +3031,7 @@ private:
     if (!ok) {
       BAD_EXPECT("right angle bracket");
     }
-    VAST c;
+    VAST c(this);
     c.push_back(getAdv());
     // TODO: why cannot I use { getAdv() } as the 2nd argument
     return get(ASTType::CloseAngleBracket, move(c));
@@ -2333,59 +3039,59 @@ private:
 
   AST qualifiedId() {
     AST node;
-    if (node = BT(qualifiedIdA)) {
+    if ((node = BT(qualifiedIdA))) {
       return node;
     } else {
-      VAST c;
-      c.push_back(expect(OP_COLON2));
+      VAST c(this);
+      PUSH(expect(OP_COLON2));
       if (isIdentifier()) {
         c.push_back(getAdv(ASTType::Identifier));
       } else {
         (node = BT(operatorFunctionId)) ||
         (node = BT(literalOperatorId)) ||
         (node = TR(templateId));
-        c.push_back(move(node));
+        PUSH(move(node));
       }
       return getAST(QualifiedId);
     }
   }
 
   AST templateId() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(simpleTemplateId)) {
-      c.push_back(move(node));
+    if ((node = BT(simpleTemplateId))) {
+      PUSH(move(node));
     } else {
       (node = BT(operatorFunctionId)) ||
       (node = TR(literalOperatorId));
-      c.push_back(move(node));
-      c.push_back(expect(OP_LT_TEMPLATE));
+      PUSH(move(node));
+      PUSH(expect(OP_LT_TEMPLATE));
       zeroOrOne(templateArgumentList);
-      c.push_back(TR(closeAngleBracket));
+      PUSH(TR(closeAngleBracket));
     }
     return getAST(TemplateId);
   }
 
   AST qualifiedIdA() {
-    VAST c;
-    c.push_back(TR(nestedNameSpecifier));
+    VAST c(this);
+    PUSH(TR(nestedNameSpecifier));
     if (isSimple(KW_TEMPLATE)) {
       c.push_back(getAdv());
     }
-    c.push_back(TR(unqualifiedId));
+    PUSH(TR(unqualifiedId));
     return getAST(QualifiedId);
   }
 
   AST decltypeSpecifier() {
-    VAST c;
+    VAST c(this);
     // TODO: here we follow the convention that a function should not assume
     // its caller has checked the initial sequence of tokens
     // This is not the most efficient implementation and is worth considering
     // consolidating in the future
-    c.push_back(expect(KW_DECLTYPE));
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(expression));
-    c.push_back(expect(OP_RPAREN));
+    PUSH(expect(KW_DECLTYPE));
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(expression));
+    PUSH(expect(OP_RPAREN));
     return get(ASTType::DecltypeSpecifier, move(c));
   }
 
@@ -2394,26 +3100,26 @@ private:
    * ===================
    */
   AST lambdaExpression() {
-    VAST c;
-    c.push_back(TR(lambdaIntroducer));
+    VAST c(this);
+    PUSH(TR(lambdaIntroducer));
     zeroOrOne(lambdaDeclarator);
-    c.push_back(TR(compoundStatement));
+    PUSH(TR(compoundStatement));
     return getAST(LambdaExpression);
   }
 
   AST lambdaIntroducer() {
-    VAST c;
-    c.push_back(expect(OP_LSQUARE));
+    VAST c(this);
+    PUSH(expect(OP_LSQUARE));
     zeroOrOne(lambdaCapture);
-    c.push_back(expect(OP_RSQUARE));
+    PUSH(expect(OP_RSQUARE));
     return getAST(LambdaIntroducer);
   }
 
   AST lambdaDeclarator() {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(parameterDeclarationClause));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(parameterDeclarationClause));
+    PUSH(expect(OP_RPAREN));
     if (isSimple(KW_MUTABLE)) {
       c.push_back(getAdv());
     }
@@ -2424,16 +3130,16 @@ private:
   }
 
   AST lambdaCapture() {
-    VAST c;
+    VAST c(this);
     AST node;
-    if (node = BT(captureDefault)) {
-      c.push_back(move(node));
+    if ((node = BT(captureDefault))) {
+      PUSH(move(node));
       if (isSimple(OP_COMMA)) {
         c.push_back(getAdv());
-        c.push_back(TR(captureList));
+        PUSH(TR(captureList));
       }
     } else {
-      c.push_back(TR(captureList));
+      PUSH(TR(captureList));
     }
     return getAST(LambdaCapture);
   }
@@ -2451,8 +3157,8 @@ private:
   }
 
   AST captureListAtom() {
-    VAST c;
-    c.push_back(TR(capture));
+    VAST c(this);
+    PUSH(TR(capture));
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -2460,14 +3166,14 @@ private:
   }
 
   AST capture() {
-    VAST c;
+    VAST c(this);
     if (isSimple(KW_THIS)) {
       c.push_back(getAdv());
     } else {
       if (isSimple(OP_AMP)) {
         c.push_back(getAdv());
       }
-      c.push_back(expectIdentifier());
+      PUSH(expectIdentifier());
     }
     return getAST(Capture);
   }
@@ -2477,46 +3183,46 @@ private:
    * ===============
    */
   AST newExpression() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_COLON2)) {
       c.push_back(getAdv());
     }
-    c.push_back(expect(KW_NEW));
+    PUSH(expect(KW_NEW));
     zeroOrOne(newPlacement);
     if (isSimple(OP_LPAREN)) {
       c.push_back(getAdv());
-      c.push_back(TR(typeId));
-      c.push_back(expect(OP_RPAREN));
+      PUSH(TR(typeId));
+      PUSH(expect(OP_RPAREN));
     } else {
-      c.push_back(TR(newTypeId));
+      PUSH(TR(newTypeId));
     }
     zeroOrOne(newInitializer);
     return getAST(NewExpression);
   }
 
   AST newInitializer() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LPAREN)) {
-      c.push_back(expect(OP_LPAREN));
+      PUSH(expect(OP_LPAREN));
       zeroOrOne(expressionList);
-      c.push_back(expect(OP_RPAREN));
+      PUSH(expect(OP_RPAREN));
     } else {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     }
     return getAST(NewInitializer);
   }
 
   AST newPlacement() {
-    VAST c;
-    c.push_back(expect(OP_LPAREN));
-    c.push_back(TR(expressionList));
-    c.push_back(expect(OP_RPAREN));
+    VAST c(this);
+    PUSH(expect(OP_LPAREN));
+    PUSH(TR(expressionList));
+    PUSH(expect(OP_RPAREN));
     return getAST(NewPlacement);
   }
 
   AST newTypeId() {
-    VAST c;
-    c.push_back(TR(typeSpecifierSeq));
+    VAST c(this);
+    PUSH(TR(typeSpecifierSeq));
     zeroOrOne(newDeclarator);
     return getAST(NewTypeId);
   }
@@ -2529,50 +3235,50 @@ private:
   }
 
   AST newDeclaratorA() {
-    VAST c;
+    VAST c(this);
     zeroOrMore(ptrOperator);
-    c.push_back(TR(noptrNewDeclarator));
+    PUSH(TR(noptrNewDeclarator));
     return getAST(NewDeclarator);
   }
 
   AST newDeclaratorB() {
-    VAST c;
+    VAST c(this);
     oneOrMore(ptrOperator);
     return getAST(NewDeclarator);
   }
 
   AST noptrNewDeclarator() {
-    VAST c;
-    c.push_back(expect(OP_LSQUARE));
-    c.push_back(TR(expression));
-    c.push_back(expect(OP_RSQUARE));
+    VAST c(this);
+    PUSH(expect(OP_LSQUARE));
+    PUSH(TR(expression));
+    PUSH(expect(OP_RSQUARE));
     zeroOrMore(attributeSpecifier);
     zeroOrMore(noptrNewDeclaratorSuffix);
     return getAST(NoptrNewDeclarator);
   }
 
   AST noptrNewDeclaratorSuffix() {
-    VAST c;
-    c.push_back(expect(OP_LSQUARE));
-    c.push_back(TR(constantExpression));
-    c.push_back(expect(OP_RSQUARE));
+    VAST c(this);
+    PUSH(expect(OP_LSQUARE));
+    PUSH(TR(constantExpression));
+    PUSH(expect(OP_RSQUARE));
     zeroOrMore(attributeSpecifier);
     return getAST(NoptrNewDeclaratorSuffix);
   }
 
   AST deleteExpression() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_COLON2)) {
       c.push_back(getAdv());
     }
-    c.push_back(expect(KW_DELETE));
+    PUSH(expect(KW_DELETE));
     AST node;
-    if (node = BT(castExpression)) {
-      c.push_back(move(node));
+    if ((node = BT(castExpression))) {
+      PUSH(move(node));
     } else {
-      c.push_back(expect(OP_LSQUARE));
-      c.push_back(expect(OP_RSQUARE));
-      c.push_back(TR(castExpression));
+      PUSH(expect(OP_LSQUARE));
+      PUSH(expect(OP_RSQUARE));
+      PUSH(TR(castExpression));
     }
     return getAST(DeleteExpression);
   }
@@ -2582,11 +3288,11 @@ private:
    * ====================
    */
   AST initializerClause() {
-    VAST c;
+    VAST c(this);
     if (isSimple(OP_LBRACE)) {
-      c.push_back(TR(bracedInitList));
+      PUSH(TR(bracedInitList));
     } else {
-      c.push_back(TR(assignmentExpression));
+      PUSH(TR(assignmentExpression));
     }
     // normally we want to swallow initializerClause,
     // but it's clearer to keep it in the parse tree
@@ -2594,21 +3300,21 @@ private:
   }
 
   AST bracedInitList() {
-    VAST c;
-    c.push_back(expect(OP_LBRACE));
+    VAST c(this);
+    PUSH(expect(OP_LBRACE));
     if (!isSimple(OP_LBRACE)) {
-      c.push_back(TR(initializerList));
+      PUSH(TR(initializerList));
       if (isSimple(OP_COMMA)) {
         c.push_back(getAdv());
       }
     }
-    c.push_back(expect(OP_RBRACE));
+    PUSH(expect(OP_RBRACE));
     return get(ASTType::BracedInitList, move(c));
   }
 
   AST initializerList() {
-    VAST c;
-    c.push_back(TR(initializerClauseDots));
+    VAST c(this);
+    PUSH(TR(initializerClauseDots));
     while (isSimple(OP_COMMA)) {
       // Here we need to look ahead 2 chars
       if (nextIsSimple(OP_RBRACE)) {
@@ -2620,14 +3326,14 @@ private:
       // TODO; here is an example chance where we can use FIRST and/or
       // FOLLOW to prune
       c.push_back(getAdv());
-      c.push_back(TR(initializerClauseDots));
+      PUSH(TR(initializerClauseDots));
     }
     return get(ASTType::InitializerList, move(c));
   }
 
   AST initializerClauseDots() {
-    VAST c;
-    c.push_back(TR(initializerClause));
+    VAST c(this);
+    PUSH(TR(initializerClause));
     if (isSimple(OP_DOTS)) {
       c.push_back(getAdv());
     }
@@ -2639,8 +3345,8 @@ private:
    * ==================
    */
   AST throwExpression() {
-    VAST c;
-    c.push_back(expect(KW_THROW));
+    VAST c(this);
+    PUSH(expect(KW_THROW));
     zeroOrOne(assignmentExpression);
     return getAST(ThrowExpression);
   }
@@ -2650,15 +3356,16 @@ private:
    * ===================
    */
   struct ParserState {
-    ParserState(size_t i, const vector<size_t>& b)
-      : index(i), brackets(b) { }
+    ParserState(size_t i, const vector<size_t>& b, Arena::Mark m)
+      : index(i), brackets(b), mark(m) { }
     size_t index;
     vector<size_t> brackets;
+    Arena::Mark mark;
   };
 
   typedef AST (ParserImp::*SubParser)();
-  AST get(ASTType type = ASTType::Terminal) const {
-    return make_unique<ASTNode>(type, &cur());
+  AST get(ASTType type = ASTType::Terminal) {
+    return arena_.make<ASTNode>(type, index_);
   }
   AST getAdv(ASTType type = ASTType::Terminal, 
              bool treatLtAsTemplateDelimiter = false) {
@@ -2666,12 +3373,17 @@ private:
     adv(treatLtAsTemplateDelimiter);
     return r;
   }
-  AST get(ASTType type, VAST&& c) const {
-    return make_unique<ASTNode>(type, move(c));
+  AST get(ASTType type, VAST&& c) {
+    size_t n = c.size();
+    auto children = 
+      static_cast<AST*>(arena_.allocate(n * sizeof(AST), alignof(AST)));
+    copy(c.data(), c.data() + n, children);
+    c.clear();
+    return arena_.make<ASTNode>(type, children, n);
   }
 
-  const Token& cur() const {
-    return *tokens_[index_];
+  TokenRef cur() const {
+    return tokens_[index_];
   }
   size_t curPos() const {
     return index_;
@@ -2683,9 +3395,9 @@ private:
 
   // We rarely need to look ahead 2 chars
   // but in certain cases we do
-  const Token& next() const {
+  TokenRef next() const {
     CHECK(index_ + 1 < tokens_.size());
-    return *tokens_[index_ + 1];
+    return tokens_[index_ + 1];
   }
   void adv(bool treatLtAsTemplateDelimiter) { 
     if (option_.isTrace) {
@@ -2707,7 +3419,7 @@ private:
   // TODO: consider making this a separate class
   // Maintain nested levels of brackets
   void handleBrackets(bool treatLtAsTemplateDelimiter) {
-    static map<ETokenType, ETokenType> mapping {
+    static const map<ETokenType, ETokenType> mapping {
       { OP_RSQUARE, OP_LSQUARE },
       { OP_RPAREN, OP_LPAREN },
       { OP_RBRACE, OP_LBRACE }
@@ -2718,7 +3430,7 @@ private:
       brackets_.push_back(index_);
       // traceBrackets();
     } else if (isSimple({OP_RSQUARE, OP_RPAREN, OP_RBRACE})) {
-      auto lhs = mapping[getSimpleTokenType(cur())];
+      auto lhs = mapping.at(getSimpleTokenType(cur()));
 
       // traceBrackets();
       
@@ -2750,7 +3462,7 @@ private:
   }
   ETokenType bracketsBack() const {
     CHECK(!brackets_.empty());
-    return getSimpleTokenType(*tokens_[brackets_.back()]);
+    return getSimpleTokenType(tokens_[brackets_.back()]);
   }
   bool treatRAngleBracketAsOperator() const {
     return brackets_.empty() || 
@@ -2767,23 +3479,25 @@ private:
     };
     cout << "Brackets: ";
     for (auto b : brackets_) {
-      cout << m[getSimpleTokenType(*tokens_[b])];
+      cout << m[getSimpleTokenType(tokens_[b])];
     }
     cout << endl;
   }
 
-  void complainExpect(string&& expected, const char* func) const {
-    Throw("[{}] expect {}; got: {}", 
-          func,
-          move(expected),
-          cur().toStr());
+  // no formatting here: most failures are dropped by attempt()
+  template<typename Expected>
+  AST complainExpect(Expected expected, const char* func) {
+    failure_ = ParseFailure(func, expected, index_);
+    furthest_.record(failure_);
+    failed_ = true;
+    return nullptr;
   }
 
   AST expectFromFunc(ETokenType type, const char* func) {
     // Note: this treatmeant requires OP_LT_TEMPLATE be sent through expect()
     auto expectedType = type == OP_LT_TEMPLATE ? OP_LT : type;
     if (!isSimple(expectedType)) {
-      complainExpect(getSimpleTokenTypeName(expectedType), func);
+      return complainExpect(expectedType, func);
     }
     return getAdv(ASTType::Terminal, type == OP_LT_TEMPLATE);
   }
@@ -2793,7 +3507,7 @@ private:
                              const vector<ETokenType>& tokens, 
                              const char *func) {
     if (!isSimple(tokens)) {
-      complainExpect(name, func);
+      return complainExpect(name, func);
     }
     return getAdv(type);
   }
@@ -2811,10 +3525,9 @@ private:
     return getAdv(ASTType::Identifier);
   }
 
-// TODO: this involves a copy
 #define GEN_IS_NAME(func) \
   bool func() const {\
-    return isIdentifier() && PA6::func(cur().toSimpleStr());\
+    return isIdentifier() && PA6::func(cur().source());\
   }
   GEN_IS_NAME(isClassName)
   GEN_IS_NAME(isTemplateName)
@@ -2840,10 +3553,10 @@ private:
     return getAdv();
   }
   // TODO: move this to util
-  ETokenType getSimpleTokenType(const Token& token) const {
+  ETokenType getSimpleTokenType(TokenRef token) const {
     // can consider removing this check
     CHECK(token.isSimple());
-    return static_cast<const TokenSimple&>(token).type;
+    return token.simpleType();
   }
   bool isSimple(ETokenType type) const {
     if (!cur().isSimple()) {
@@ -2896,25 +3609,28 @@ private:
    * ====================
    */
   bool isStFinal() const {
-    return isIdentifier() && cur().toSimpleStr() == "final";
+    return isIdentifier() && cur().source() == "final";
   }
   bool isStOverride() const {
-    return isIdentifier() && cur().toSimpleStr() == "override";
+    return isIdentifier() && cur().source() == "override";
   }
 
   // Note: it is possible to use the follow set when FIRST does not match to
   // efficiently rule out the e-derivation - this might be helpful in emitting
   // useful error messages
-  // @parseSep - return nullptr to indicate a non-match; throw to indicate parse
-  //             failure
+  // @parseSep - return nullptr to indicate a non-match, and set failed_ as
+  //             well to indicate parse failure
   AST conditionalRepeat(ASTType type, 
                         function<AST ()> subParser,
                         function<AST ()> parseSep) {
-    VAST c;
-    c.push_back(subParser());
+    VAST c(this);
+    PUSH(subParser());
     while (AST sep = parseSep()) {
-      c.push_back(move(sep));
-      c.push_back(subParser());
+      c.push_back(sep);
+      PUSH(subParser());
+    }
+    if (failed_) {
+      return nullptr;
     }
     return get(type, move(c));
   }
@@ -2955,35 +3671,42 @@ private:
     }
   }
 
-  void oneOrMoreInternal(VAST& c, 
+  // false if first fails
+  bool oneOrMoreInternal(VAST& c, 
                          function<AST ()> first, 
                          function<AST ()> rest) {
-    c.push_back(first());
-    while (AST node = rest()) {
+    AST node = first();
+    if (!node) {
+      return false;
+    }
+    c.push_back(node);
+    while ((node = rest())) {
       c.push_back(move(node));
     }
+    return true;
   }
 
   /* ===========================
    *  traced call functionality
    * ===========================
    */
+  // cheap enough to be on every rule call when not tracing
   class Trace {
   public:
     static const char* padding() {
       return "  ";
     }
     Trace(bool isTrace,
-          string&& name, 
-          function<const Token& ()> curTokenGetter,
+          const char* name, 
+          const ParserImp* parser,
           int& traceDepth)
       : isTrace_(isTrace),
-        name_(move(name)),
-        curTokenGetter_(curTokenGetter),
+        name_(name),
+        parser_(parser),
         traceDepth_(traceDepth)  {
       if (isTrace_) {
         tracePadding();
-        cout << format("--> {} [{}]\n", name_, curTokenGetter_().toStr());
+        cout << format("--> {} [{}]\n", name_, parser_->cur().toStr());
         ++traceDepth_;
       } 
     }
@@ -2994,7 +3717,7 @@ private:
         cout << format("<-- {} {} [{}]\n", 
                        name_, 
                        ok_ ? "OK" : "BAD",
-                       curTokenGetter_().toStr());
+                       parser_->cur().toStr());
       }
     }
     void success() { ok_ = true; }
@@ -3006,41 +3729,229 @@ private:
     }
 
     bool isTrace_;
-    string name_;
-    function<const Token& ()> curTokenGetter_;
+    const char* name_;
+    const ParserImp* parser_;
     int& traceDepth_;
     bool ok_ { false };
   };
   
   AST tracedCall(SubParser parser, const char* name) {
-    Trace trace(option_.isTrace, name, bind(&ParserImp::cur, this), traceDepth_);
+    RuleProfile::Call call(profile_, name, index_);
+    Trace trace(option_.isTrace, name, this, traceDepth_);
     AST root = CALL_MEM_FUNC(*this, parser)();
-    trace.success();
+    if (!failed_) {
+      trace.success();
+      call.success();
+    }
     return root;
   }
 
+  /* ===================================
+   *  predictive dispatch and memoization
+   * ===================================
+   */
+  // A backtracked rule is not tried at all if its FIRST set excludes the
+  // current token. Otherwise, since a rule only depends on the token index
+  // and the open brackets (which decide whether '>' closes a template
+  // argument list), its outcome at a position can be replayed instead of
+  // parsing again.
+  struct BacktrackRule {
+    // memo id
+    int id;
+    MemoMode mode;
+    // the rule in RecognizerGrammar
+    int first;
+  };
+  struct MemoEntry {
+    // open brackets when the rule was entered
+    vector<size_t> startBrackets;
+    bool ok;
+    // nodes are never changed once built, so a replay shares them
+    AST root;
+    size_t index;
+    vector<size_t> brackets;
+  };
+
+  const BacktrackRule& backtrackRule(const char* name) {
+    auto it = backtrackRules_.find(name);
+    if (it != backtrackRules_.end()) {
+      return it->second;
+    }
+    BacktrackRule rule { -1, 
+                         option_.isTrace ? MemoMode::Off : option_.memoMode,
+                         -1 };
+    auto itMode = option_.ruleMemoModes.find(name);
+    if (!option_.isTrace && itMode != option_.ruleMemoModes.end()) {
+      rule.mode = itMode->second;
+    }
+    if (rule.mode != MemoMode::Off) {
+      CHECK(memoRuleNames_.size() < (1 << 16));
+      rule.id = memoRuleNames_.insert(
+                  make_pair(string(name), 
+                            static_cast<int>(memoRuleNames_.size())))
+                  .first->second;
+    }
+    rule.first = firstSets().rule(name);
+    MCHECK(rule.first >= 0, format("{} is not in the grammar", name));
+    return backtrackRules_.insert(make_pair(name, rule)).first->second;
+  }
+
+  uint64_t memoKey(const BacktrackRule& rule) const {
+    return (static_cast<uint64_t>(index_) << 16) | 
+           static_cast<uint64_t>(rule.id);
+  }
+
+  static const FirstSets& firstSets() {
+    static const FirstSets sets(RecognizerGrammar);
+    return sets;
+  }
+
+  // Tries a rule prediction skipped, which must then fail without getting
+  // past its first token: otherwise RecognizerGrammar is out of step with
+  // the rule.
+  void checkPrediction(SubParser parser, const char* name) {
+    ParserState state { index_, brackets_, arena_.mark() };
+    FurthestFailure furthest;
+    swap(furthest, furthest_);
+    ++backtrackDepth_;
+    bool ok = tracedCall(parser, name) && !failed_;
+    failed_ = false;
+    --backtrackDepth_;
+    MCHECK(!ok && !furthest_.reached(state.index + 1),
+           format("{} was predicted to fail on {}, but it gets past it",
+                  name,
+                  tokens_.toStr(state.index)));
+    swap(furthest, furthest_);
+    arena_.rollback(state.mark < memoMark_ ? memoMark_ : state.mark);
+    reset(move(state));
+  }
+
   AST backtrack(SubParser parser, const char *name) {
-    ParserState state { index_, brackets_ };
-    try {
-      return tracedCall(parser, name);
-    } catch (const CompilerException&) {
-      reset(move(state));
+    const BacktrackRule& rule = backtrackRule(name);
+    if (!firstSets().mayStart(rule.first, cur())) {
+      // The rule would fail on its first token. Whether or not it is tried,
+      // it is recorded as expecting the rule rather than the tokens it
+      // could start with, so the diagnostic does not depend on prediction.
+      if (option_.isPredictive && !option_.isTrace) {
+        TimeReport::count(TimeReport::Predictions);
+        if (option_.isPredictionChecked) {
+          checkPrediction(parser, name);
+        }
+      } else {
+        FurthestFailure furthest;
+        swap(furthest, furthest_);
+        bool ok;
+        AST root = attempt(parser, name, rule, &ok);
+        swap(furthest, furthest_);
+        if (ok) {
+          return root;
+        }
+      }
+      furthest_.record(
+        ParseFailure(name, firstSets().description(rule.first), index_));
       return nullptr;
     }
+    bool ok;
+    return attempt(parser, name, rule, &ok);
+  }
+
+  // Parses a backtracked rule, or replays its memoized outcome; a failure
+  // leaves the parser where it was.
+  AST attempt(SubParser parser, 
+              const char* name, 
+              const BacktrackRule& rule, 
+              bool* ok) {
+    *ok = true;
+    if (rule.mode != MemoMode::Off) {
+      auto it = memo_.find(memoKey(rule));
+      if (it != memo_.end() && it->second.startBrackets == brackets_) {
+        TimeReport::count(TimeReport::MemoHits);
+        const MemoEntry& e = it->second;
+        if (!e.ok) {
+          *ok = false;
+          return nullptr;
+        }
+        index_ = e.index;
+        brackets_ = e.brackets;
+        return e.root;
+      }
+    }
+
+    uint64_t key = memoKey(rule);
+    ParserState state { index_, brackets_, arena_.mark() };
+    ++backtrackDepth_;
+    AST root = tracedCall(parser, name);
+    *ok = root && !failed_;
+    failed_ = false;
+    if (!*ok) {
+      TimeReport::count(TimeReport::Backtracks);
+    }
+    if (--backtrackDepth_ == 0) {
+      // The entries go when an outermost backtracked rule returns. If it
+      // matched, nothing before its end is parsed again. If it failed, the
+      // next alternative parses its tokens again and might have hit some of
+      // them, but dropping them lets the nodes of the failed attempt go too,
+      // so the memo never holds more than one outermost attempt.
+      memo_.clear();
+      memoMark_ = Arena::Mark { 0, 0 };
+    } else if (rule.mode == MemoMode::All || 
+               (rule.mode == MemoMode::Failures && !*ok)) {
+      MemoEntry& e = memo_[key];
+      e.startBrackets = state.brackets;
+      e.ok = *ok;
+      e.root = root;
+      if (*ok && memoMark_ < arena_.mark()) {
+        memoMark_ = arena_.mark();
+      }
+      e.index = index_;
+      e.brackets = brackets_;
+    }
+    if (!*ok) {
+      // drop the nodes of the failed attempt, but not any a memo entry
+      // still refers to
+      arena_.rollback(state.mark < memoMark_ ? memoMark_ : state.mark);
+      reset(move(state));
+    }
+    return root;
   }
 
-  const vector<UToken>& tokens_;
+  TokenBuffer& tokens_;
   size_t index_ { 0 };
 
   ParserOption option_;
   int traceDepth_ { 0 };
+  RuleProfile profile_;
 
   vector<size_t> brackets_;
+
+  // the last failure; see PUSH
+  bool failed_ { false };
+  ParseFailure failure_ { nullptr, nullptr, 0 };
+  FurthestFailure furthest_;
+
+  int backtrackDepth_ { 0 };
+  unordered_map<const char*, BacktrackRule> backtrackRules_;
+  map<string, int> memoRuleNames_;
+  // keyed by token index and rule id, see memoKey
+  unordered_map<uint64_t, MemoEntry> memo_;
+  // the end of the nodes of memoized successes
+  Arena::Mark memoMark_ { 0, 0 };
+
+  ParserArenas& arenas_;
+  Arena& arena_;
+  // placeholders of deferred bodies by the index of their '{', allocated
+  // from arenas_.bodies since a backtrack may drop the nodes of an
+  // attempt, but not these
+  bool deferBodies_ { false };
+  map<size_t, ASTNode*> deferredBodies_;
+  vector<AST> children_;
+  int childrenDepth_ { 0 };
 };
 
 AST Parser::process()
 {
-  return ParserImp(tokens_, option_).process();
+  TimeReport::Scope scope(TimeReport::Parser);
+  return ParserImp(tokens_, option_, arenas_, arenas_.nodes).process();
 }
 
 }
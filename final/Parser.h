@@ -1,7 +1,13 @@
 #pragma once
 #include "parsers/ParserCommon.h"
-#include "Token.h"
+#include "TokenBuffer.h"
 #include "ASTType.h"
+#include "Arena.h"
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace compiler
@@ -9,18 +15,34 @@ namespace compiler
 
 // Print AST can use LISP style
 struct ASTNode;
-typedef std::unique_ptr<ASTNode> AST;
+// nodes live in the arena of the Parser that built them
+typedef const ASTNode* AST;
+
+// the children of a node, an array in the same arena allocated just before
+// the node itself
+struct ASTChildren
+{
+  const AST* begin() const { return data; }
+  const AST* end() const { return data + count; }
+  size_t size() const { return count; }
+  const AST& front() const { return data[0]; }
+
+  const AST* data;
+  size_t count;
+};
+
 struct ASTNode
 {
-  ASTNode(ASTType _type, const Token* _token)
+  ASTNode(ASTType _type, size_t _token)
     : type(_type),
       isTerminal(true),
-      token(_token) { }
-  ASTNode(ASTType _type, std::vector<AST>&& _children)
+      token(_token),
+      children { nullptr, 0 } { }
+  ASTNode(ASTType _type, const AST* _children, size_t count)
     : type(_type),
       isTerminal(false),
-      token(nullptr),
-      children(std::move(_children)) { 
+      token(0),
+      children { _children, count } { 
     for (auto& c : children) {
       MCHECK(
          c,
@@ -29,27 +51,91 @@ struct ASTNode
     }
   }
 
-  std::string toStr(std::string indent, bool collapse) const;
-  std::string toStr(bool collapse = false) const {
-    return toStr("", collapse);
+  std::string toStr(const TokenBuffer& tokens,
+                    std::string indent,
+                    bool collapse) const;
+  std::string toStr(const TokenBuffer& tokens, bool collapse = false) const {
+    return toStr(tokens, "", collapse);
   }
 
   ASTType type;
   bool isTerminal;
-  const Token* token;
-  std::vector<AST> children; 
+  // index of a terminal's token
+  size_t token;
+  ASTChildren children; 
+};
+
+// Writes trees through a buffer of its own, so that an unbuffered stream
+// like cerr sees a few large writes rather than several per node.
+class ASTWriter
+{
+public:
+  ASTWriter(std::ostream& out, const TokenBuffer& tokens)
+    : out_(out),
+      tokens_(tokens) { }
+  ~ASTWriter() {
+    flush();
+  }
+
+  // the text of ASTNode::toStr
+  void writeText(AST root, bool collapse, const std::string& indent = "");
+
+  // Preorder encoding of the whole (uncollapsed) tree:
+  //   "AST1", a count and that many (type, type name) pairs
+  //   per node: type << 1 | isTerminal, then
+  //     terminal: id << 1 | isNew, followed by the text if new, where ids
+  //               number the distinct terminal texts in order of appearance
+  //     otherwise: the number of children, then the children
+  // Numbers are varints (7 bits a byte, low bits first) and texts are a
+  // length followed by the bytes.
+  void writeBinary(AST root);
+
+  void flush();
+
+private:
+  void text(AST node, bool collapse);
+  void binary(AST node);
+  const std::string& typeName(ASTType type);
+  void put(const char* s, size_t n);
+  void put(const std::string& s) {
+    put(s.data(), s.size());
+  }
+  void putVarint(uint64_t n);
+
+  std::ostream& out_;
+  const TokenBuffer& tokens_;
+  std::string buffer_;
+  std::string indent_;
+  std::vector<std::string> typeNames_;
+  std::unordered_map<std::string, uint64_t> terminalIds_;
+};
+
+// Writes a tree read from what ASTWriter::writeBinary wrote as
+// ASTWriter::writeText would, followed by a new line
+void decodeBinaryAST(std::istream& in, std::ostream& out, bool collapse);
+
+// Where the nodes of a Parser live
+struct ParserArenas
+{
+  Arena nodes;
+  // placeholders of deferred function bodies (see BodyMode)
+  Arena bodies;
+  // one for each thread parsing deferred bodies
+  std::deque<Arena> workers;
 };
 
 class Parser
 {
 public:
-  Parser(const std::vector<UToken>& tokens, const ParserOption& option)
+  Parser(TokenBuffer& tokens, const ParserOption& option)
     : tokens_(tokens),
       option_(option) { }
+  // the tree lives as long as this Parser
   AST process();
 private:
-  const std::vector<UToken>& tokens_;
+  TokenBuffer& tokens_;
   const ParserOption option_;
+  ParserArenas arenas_;
 };
 
 }
@@ -11,8 +11,10 @@ class TokenReceiver
 {
 public:
   TokenReceiver(
-    const std::function<void (const Token&)>& send = [](const Token&){}) 
-    : send_(send) {
+    const std::function<void (const Token&)>& send = [](const Token&){},
+    const std::function<void (const SpelledToken&)>& sendSpelled = nullptr) 
+    : send_(send),
+      sendSpelled_(sendSpelled) {
   }
 
   void put(const Token& token) {
@@ -20,6 +22,15 @@ public:
     send_(token);
   }
 
+  // Simple tokens and identifiers may be put by spelling instead, if the
+  // receiver was given somewhere to send them.
+  bool takesSpelled() const {
+    return static_cast<bool>(sendSpelled_);
+  }
+  void put(const SpelledToken& token) {
+    sendSpelled_(token);
+  }
+
 private:
   void printToken(const Token& token) const {
     std::cout << token.toStr() << std::endl;
@@ -32,6 +43,7 @@ private:
   }
 
   std::function<void (const Token&)> send_;
+  std::function<void (const SpelledToken&)> sendSpelled_;
 };
 
 }
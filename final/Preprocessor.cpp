@@ -2,6 +2,7 @@
 #include "common.h"
 #include "preprocessing_token/PPTokenizer.h"
 #include "PPDirective.h"
+#include "TimeReport.h"
 
 namespace compiler { 
 
@@ -9,7 +10,7 @@ using namespace std;
 
 void Preprocessor::process()
 {
-  TokenReceiver postTokenReceiver(send_);
+  TokenReceiver postTokenReceiver(send_, sendSpelled_);
   Tokenizer postTokenizer(postTokenReceiver);
 
   PPDirective ppDirective(bind(&Tokenizer::put, 
@@ -23,11 +24,21 @@ void Preprocessor::process()
                      &ppDirective,
                      placeholders::_1));
 
-  for (char c; sourceReader_.get(c); )
-  {
-    ppTokenizer.process(static_cast<unsigned char>(c));
+  for (;;) {
+    const char* begin, *end;
+    {
+      TimeReport::Scope scope(TimeReport::SourceReader);
+      if (!sourceReader_.getLine(begin, end)) {
+        break;
+      }
+      TimeReport::count(TimeReport::Lines);
+      TimeReport::count(TimeReport::Bytes, end - begin);
+    }
+    TimeReport::Scope scope(TimeReport::PPTokenizer);
+    ppTokenizer.process(begin, end);
   }
 
+  TimeReport::Scope scope(TimeReport::PPTokenizer);
   ppTokenizer.process(EndOfFile);
 }
 
@@ -16,17 +16,23 @@ class TokenReceiver;
 class Preprocessor
 {
 public:
+  // sendSpelled, if given, takes the simple tokens and identifiers instead
+  // of send (see TokenReceiver)
   Preprocessor(BuildEnv buildEnv,
                const std::string& source,
-               std::function<void (const Token&)> send)
+               std::function<void (const Token&)> send,
+               std::function<void (const SpelledToken&)> sendSpelled = 
+                 nullptr)
     : buildEnv_(buildEnv),
       sourceReader_(source),
-      send_(send) { }
+      send_(send),
+      sendSpelled_(sendSpelled) { }
 
   void process();
 private:
   BuildEnv buildEnv_;
   SourceReader sourceReader_;
   std::function<void (const Token&)> send_;
+  std::function<void (const SpelledToken&)> sendSpelled_;
 };
 }
@@ -0,0 +1,99 @@
+#include "RuleProfile.h"
+#include "common.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace compiler {
+
+using namespace std;
+
+#ifdef PARSER_PROFILE
+
+namespace {
+
+// leaked, so that they outlive every parser and are still there at exit
+mutex& totalsMutex()
+{
+  static mutex* m = new mutex;
+  return *m;
+}
+
+map<string, RuleProfile::Stats>& totals()
+{
+  static auto* t = new map<string, RuleProfile::Stats>;
+  return *t;
+}
+
+double ms(RuleProfile::Clock::duration d)
+{
+  return chrono::duration<double, milli>(d).count();
+}
+
+}
+
+bool RuleProfile::enabled_ = false;
+
+void RuleProfile::parseCommandline(vector<string>& args)
+{
+  if (hasCommandlineSwitch(args, "--rule-profile") && !enabled_) {
+    enabled_ = true;
+    atexit(print);
+  }
+}
+
+RuleProfile::~RuleProfile()
+{
+  lock_guard<mutex> lock(totalsMutex());
+  for (auto& e : rules_) {
+    Stats& total = totals()[e.first];
+    total.calls += e.second.calls;
+    total.failures += e.second.failures;
+    total.consumed += e.second.consumed;
+    total.reexamined += e.second.reexamined;
+    total.time += e.second.time;
+  }
+}
+
+void RuleProfile::print()
+{
+  lock_guard<mutex> lock(totalsMutex());
+  vector<pair<string, Stats>> rules(totals().begin(), totals().end());
+  stable_sort(rules.begin(), rules.end(),
+              [](const pair<string, Stats>& a, const pair<string, Stats>& b) {
+                return a.second.time > b.second.time;
+              });
+
+  ostream& out = cerr;
+  out << "rule profile (inclusive wall ms)" << endl;
+  out << "  " << left << setw(32) << "rule" << right
+      << setw(10) << "ms"
+      << setw(10) << "calls"
+      << setw(10) << "failed"
+      << setw(12) << "consumed"
+      << setw(12) << "reexamined" << endl;
+  for (auto& e : rules) {
+    out << "  " << left << setw(32) << e.first << right
+        << setw(10) << fixed << setprecision(2) << ms(e.second.time)
+        << setw(10) << e.second.calls
+        << setw(10) << e.second.failures
+        << setw(12) << e.second.consumed
+        << setw(12) << e.second.reexamined << endl;
+  }
+}
+
+#else
+
+void RuleProfile::parseCommandline(vector<string>& args)
+{
+  if (hasCommandlineSwitch(args, "--rule-profile")) {
+    cerr << "rule profile: not built in (make PARSER_PROFILE=1)" << endl;
+  }
+}
+
+#endif
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler {
+
+// Per-rule counts of the recursive descent parsers, taken where tracedCall
+// (recog) and Base::TR (nsdecl) enter a rule. Built only with
+// -DPARSER_PROFILE (make PARSER_PROFILE=1), otherwise every hook is empty;
+// a profiling build collects them when run with --rule-profile and prints
+// the rules sorted by time to stderr at exit.
+class RuleProfile
+{
+public:
+  // removes the switch from args
+  static void parseCommandline(std::vector<std::string>& args);
+
+#ifdef PARSER_PROFILE
+  typedef std::chrono::steady_clock Clock;
+
+  struct Stats {
+    uint64_t calls { 0 };
+    uint64_t failures { 0 };
+    // tokens consumed by the calls that succeeded
+    uint64_t consumed { 0 };
+    // tokens a failed call got past, which whatever is tried instead
+    // looks at again
+    uint64_t reexamined { 0 };
+    // inclusive, counting only the outermost call of a recursive rule
+    Clock::duration time { 0 };
+    int active { 0 };
+  };
+
+  RuleProfile() = default;
+  RuleProfile(const RuleProfile&) = delete;
+  RuleProfile& operator=(const RuleProfile&) = delete;
+  // adds the counts to those of the process
+  ~RuleProfile();
+
+  // One call of a rule, reading the parser's token index when it starts
+  // and when it ends, be it by returning or by an exception
+  class Call {
+  public:
+    Call(RuleProfile& profile, const char* rule, const size_t& index)
+      : stats_(enabled_ ? &profile.rules_[rule] : nullptr),
+        index_(index),
+        start_(index) {
+      if (stats_ && stats_->active++ == 0) {
+        startTime_ = Clock::now();
+      }
+    }
+    ~Call() {
+      if (!stats_) {
+        return;
+      }
+      ++stats_->calls;
+      if (ok_) {
+        stats_->consumed += index_ - start_;
+      } else {
+        ++stats_->failures;
+        stats_->reexamined += index_ - start_;
+      }
+      if (--stats_->active == 0) {
+        stats_->time += Clock::now() - startTime_;
+      }
+    }
+    Call(const Call&) = delete;
+    Call& operator=(const Call&) = delete;
+
+    void success() { ok_ = true; }
+  private:
+    Stats* stats_;
+    const size_t& index_;
+    size_t start_;
+    bool ok_ { false };
+    Clock::time_point startTime_;
+  };
+
+private:
+  static void print();
+
+  static bool enabled_;
+  // by the rule names, which are string literals
+  std::unordered_map<const char*, Stats> rules_;
+#else
+  class Call {
+  public:
+    Call(RuleProfile&, const char*, const size_t&) { }
+    void success() { }
+  };
+#endif
+};
+
+}
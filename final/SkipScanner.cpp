@@ -0,0 +1,277 @@
+#include "SkipScanner.h"
+#include "common.h"
+#include <cstring>
+
+namespace compiler {
+
+using namespace std;
+
+namespace {
+
+const int End = -1;
+
+// see TrigraphDecoder
+int getTrigraph(int c) {
+  const char* from = R"(=/'()!<>-)";
+  const char* to = R"(#\^[]|{}~)";
+  for (int i = 0; from[i]; ++i) {
+    if (from[i] == c) {
+      return to[i];
+    }
+  }
+  return End;
+}
+
+bool isIdentifierChar(int c) {
+  return (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') ||
+         c == '_';
+}
+
+bool isDigit(int c) {
+  return c >= '0' && c <= '9';
+}
+
+// see Utf8Utils::isWhiteSpaceNoNewLine
+bool isWhite(int c) {
+  return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+}
+
+bool isRawStringPrefix(const string& s) {
+  return s == "R" || s == "u8R" || s == "uR" || s == "UR" || s == "LR";
+}
+
+} // anonymous
+
+size_t SkipScanner::scan(const char* begin, const char* end)
+{
+  return SkipScanner(begin, end).run();
+}
+
+int SkipScanner::getSpliced(const char*& p) const
+{
+  // LineSplicer runs before TrigraphDecoder, so only a physical '\' 
+  // followed by a new-line is a line splice
+  while (p + 1 < end_ && p[0] == '\\' && p[1] == '\n') {
+    p += 2;
+  }
+  if (p == end_) {
+    return End;
+  }
+  return static_cast<unsigned char>(*p++);
+}
+
+int SkipScanner::get()
+{
+  const char* q = p_;
+  int c = getSpliced(q);
+  if (c == '?') {
+    const char* r = q;
+    if (getSpliced(r) == '?') {
+      int t = getTrigraph(getSpliced(r));
+      if (t != End) {
+        p_ = r;
+        return t;
+      }
+    }
+  }
+  p_ = q;
+  return c;
+}
+
+int SkipScanner::peek() const
+{
+  return SkipScanner(*this).get();
+}
+
+bool SkipScanner::skipComment()
+{
+  // the leading '/' has been consumed
+  int c = get();
+  if (c == '/') {
+    while (peek() != '\n' && peek() != End) {
+      get();
+    }
+    return true;
+  }
+  CHECK(c == '*');
+  // the same transitions as CommentDecoder
+  bool star = false;
+  while ((c = get()) != End) {
+    if (star && c == '/') {
+      return true;
+    }
+    star = !star && c == '*';
+  }
+  return false;
+}
+
+void SkipScanner::skipWhiteAndComments()
+{
+  for (;;) {
+    int c = peek();
+    if (isWhite(c)) {
+      get();
+    } else if (c == '/') {
+      SkipScanner s(*this);
+      s.get();
+      int n = s.peek();
+      if ((n != '/' && n != '*') || !s.skipComment()) {
+        return;
+      }
+      *this = s;
+    } else {
+      return;
+    }
+  }
+}
+
+bool SkipScanner::skipQuoted(int quote)
+{
+  // the opening quote has been consumed; comments are not recognized inside
+  // a quoted literal. The pp-tokenizer rejects an unterminated literal (such
+  // as the apostrophe in "don't") even in a skipped group, so the line is
+  // left to it rather than skipped here.
+  for (;;) {
+    int c = peek();
+    if (c == '\n' || c == End) {
+      return false;
+    }
+    get();
+    if (c == quote) {
+      return true;
+    } else if (c == '\\') {
+      if (peek() == '\n' || peek() == End) {
+        return false;
+      }
+      get();
+    }
+  }
+}
+
+bool SkipScanner::skipRawString()
+{
+  // the opening quote has been consumed; all the decoders are turned off
+  // inside a raw string literal, so scan the physical characters
+  // (see RawStringLiteralFSM)
+  const char* open = p_;
+  while (open < end_ && 
+         *open != '(' && 
+         *open != ')' && 
+         *open != '\\' && 
+         !isWhite(*open) && 
+         *open != '\n') {
+    ++open;
+  }
+  if (open == end_ || *open != '(') {
+    return false;
+  }
+  string close = ")" + string(p_, open) + "\"";
+  for (const char* p = open + 1; p + close.size() <= end_; ++p) {
+    if (*p == ')' && memcmp(p, close.data(), close.size()) == 0) {
+      p_ = p + close.size();
+      return true;
+    }
+  }
+  return false;
+}
+
+string SkipScanner::getDirective()
+{
+  // the leading '#' has been consumed
+  skipWhiteAndComments();
+  string name;
+  while (isIdentifierChar(peek())) {
+    name.push_back(static_cast<char>(get()));
+  }
+  return name;
+}
+
+bool SkipScanner::skipLine()
+{
+  // the identifier (or pp-number) immediately preceding the current
+  // character, to recognize raw string literals
+  string identifier;
+  bool number = false;
+  for (;;) {
+    int c = get();
+    if (c == End) {
+      return false;
+    } else if (c == '\n') {
+      return true;
+    }
+
+    if (isIdentifierChar(c) || c >= 0x80 || (number && c == '.')) {
+      if (identifier.empty() && !number) {
+        number = isDigit(c);
+      }
+      if (!number) {
+        identifier.push_back(static_cast<char>(c));
+      }
+      continue;
+    }
+
+    bool raw = c == '"' && !number && isRawStringPrefix(identifier);
+    identifier.clear();
+    number = false;
+
+    if (raw) {
+      if (!skipRawString()) {
+        return false;
+      }
+    } else if (c == '"' || c == '\'') {
+      if (!skipQuoted(c)) {
+        return false;
+      }
+    } else if (c == '/' && (peek() == '/' || peek() == '*')) {
+      if (!skipComment()) {
+        return false;
+      }
+    }
+  }
+}
+
+size_t SkipScanner::run()
+{
+  for (;;) {
+    const char* lineStart = p_;
+
+    skipWhiteAndComments();
+    SkipScanner s(*this);
+    int c = s.get();
+    if (c == '%' && s.get() == ':') {
+      c = '#';
+    }
+    if (c == '#') {
+      *this = s;
+      string directive = getDirective();
+      if (directive == "if" || 
+          directive == "ifdef" || 
+          directive == "ifndef") {
+        nested_.push_back(false);
+      } else if (directive == "elif" || 
+                 directive == "else" || 
+                 directive == "endif") {
+        if (nested_.empty()) {
+          // this ends the skipped group
+          return lineStart - begin_;
+        }
+        // see PPDirective::checkElse
+        if (directive == "endif") {
+          nested_.pop_back();
+        } else if (nested_.back()) {
+          Throw("Unexpected #{} after #else", directive);
+        } else if (directive == "else") {
+          nested_.back() = true;
+        }
+      }
+    }
+
+    if (!skipLine()) {
+      return lineStart - begin_;
+    }
+  }
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace compiler {
+
+// Scans the raw source of a skipped group (see C++ standard 16.1) for the
+// directive which ends it, without running the PPTokenizer pipeline.
+// Only line splices, trigraphs, comments and literals are tracked, as far as
+// needed to recognize line-leading directives.
+class SkipScanner
+{
+public:
+  // [begin, end) must start at the beginning of a line.
+  // Returns the offset of the first line which is not part of the skipped
+  // group: the line of the matching #elif, #else or #endif, or a line the
+  // scan could not finish (e.g. an unterminated comment or literal), which
+  // is left to the regular pipeline.
+  static size_t scan(const char* begin, const char* end);
+private:
+  SkipScanner(const char* begin, const char* end)
+    : begin_(begin),
+      end_(end),
+      p_(begin) { }
+
+  // physical characters, with line splices removed
+  int getSpliced(const char*& p) const;
+  // logical characters, with line splices and trigraphs replaced
+  int get();
+  int peek() const;
+
+  void skipWhiteAndComments();
+  bool skipComment();
+  bool skipQuoted(int quote);
+  bool skipRawString();
+  std::string getDirective();
+  bool skipLine();
+  size_t run();
+
+  const char* begin_;
+  const char* end_;
+  const char* p_;
+  // true for the #if blocks nested inside the skipped group which have
+  // encountered #else
+  std::vector<bool> nested_;
+};
+
+}
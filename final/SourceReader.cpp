@@ -1,8 +1,17 @@
 #include "SourceReader.h"
+#include "SkipScanner.h"
+#include "TimeReport.h"
 #include "common.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace compiler {
 
@@ -41,6 +50,37 @@ bool PA5GetFileId(const string& path, PA5FileId& out_fileid)
 
 } // anonymous
 
+SourceReader::Source::~Source()
+{
+#ifndef WIN32
+  if (mapped) {
+    munmap(mapped, mappedSize);
+  }
+#endif
+}
+
+size_t SourceReader::Source::getLine() const
+{
+  if (pos == linePos) {
+    return line;
+  }
+  // a character starts a new line iff the character read before it is a
+  // new-line
+  return line + 
+         (previousIsNewLine ? 1 : 0) + 
+         count(linePos, pos - 1, '\n');
+}
+
+size_t& SourceReader::Source::syncLine()
+{
+  if (pos != linePos) {
+    line = getLine();
+    previousIsNewLine = pos[-1] == '\n';
+    linePos = pos;
+  }
+  return line;
+}
+
 SourceReader::SourceReader(const string& source)
 {
   open(source);
@@ -61,8 +101,32 @@ void SourceReader::open(const string& name)
       return;
     }
   }
-  
-  fstream in(name);
+
+#ifndef WIN32
+  auto source = make_unique<Source>(name);
+  int fd = ::open(name.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) {
+        madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+        source->mapped = mapped;
+        source->mappedSize = st.st_size;
+      }
+    }
+    close(fd);
+  }
+  if (source->mapped) {
+    auto data = static_cast<const char*>(source->mapped);
+    source->setData(data, data + source->mappedSize);
+    push(move(source));
+    return;
+  }
+#endif
+
+  // empty or special files
+  ifstream in(name);
   open(in, name);
 }
 
@@ -70,10 +134,37 @@ void SourceReader::open(istream& in, const string& name)
 {
   ostringstream oss;
   oss << in.rdbuf();
-  names_.push_back(name);
-  // cout << "push " << name << endl;
-  sources_.push_back(make_pair(oss.str(), 0));
-  lines_.push_back(1); 
+  auto source = make_unique<Source>(name);
+  source->data = oss.str();
+  source->setData(source->data.data(), 
+                  source->data.data() + source->data.size());
+  push(move(source));
+}
+
+void SourceReader::push(unique_ptr<Source>&& source)
+{
+  // cout << "push " << source->name << endl;
+  if (!sources_.empty()) {
+    sources_.back()->syncLine();
+    source->previousIsNewLine = sources_.back()->previousIsNewLine;
+  }
+  sources_.push_back(move(source));
+}
+
+bool SourceReader::popFinished()
+{
+  while (!sources_.empty() && 
+         sources_.back()->pos == sources_.back()->end) {
+    sources_.back()->syncLine();
+    bool previousIsNewLine = sources_.back()->previousIsNewLine;
+    sources_.pop_back();
+    if (!sources_.empty()) {
+      // the parent has not been read since the include
+      CHECK(sources_.back()->pos == sources_.back()->linePos);
+      sources_.back()->previousIsNewLine = previousIsNewLine;
+    }
+  }
+  return !sources_.empty();
 }
 
 string SourceReader::getPathRel(const string& source) const
@@ -100,28 +191,17 @@ void SourceReader::include(const string& source)
   }
 }
 
-bool SourceReader::get(char& c)
+bool SourceReader::getLine(const char*& begin, const char*& end)
 {
-  while (!sources_.empty() && 
-         sources_.back().second == sources_.back().first.size()) {
-    sources_.pop_back();
-
-    names_.pop_back();
-
-    lines_.pop_back();
-  }
-  if (sources_.empty()) {
+  if (!popFinished()) {
     return false;
   }
-  c = sources_.back().first[sources_.back().second];
-  ++sources_.back().second;
-
-  if (previousIsNewLine_) {
-    ++lines_.back();
-  }
-
-  previousIsNewLine_ = c == '\n';
-
+  auto& source = *sources_.back();
+  begin = source.pos;
+  auto newLine = static_cast<const char*>(
+                   memchr(begin, '\n', source.end - begin));
+  end = newLine ? newLine + 1 : source.end;
+  source.pos = end;
   return true;
 }
 
@@ -133,4 +213,20 @@ void SourceReader::pragmaOnce(const string& source)
   pragmaOnced_.insert(id);
 }
 
+void SourceReader::skipGroup()
+{
+  if (sources_.empty()) {
+    return;
+  }
+  TimeReport::Scope scope(TimeReport::SourceReader);
+  auto& source = *sources_.back();
+  // we can only start skipping at the beginning of a line
+  bool lineStart = source.pos != source.linePos ? 
+                     source.pos[-1] == '\n' :
+                     source.previousIsNewLine;
+  if (lineStart) {
+    source.pos += SkipScanner::scan(source.pos, source.end);
+  }
+}
+
 }
@@ -5,6 +5,7 @@
 #include <string>
 #include <set>
 #include <istream>
+#include <memory>
 
 namespace compiler {
 
@@ -19,36 +20,73 @@ class SourceReader
 public:
   // for reading from stdin
   SourceReader(std::istream& in, const std::string& source);
+  // source and include files are mapped into memory
   SourceReader(const std::string& source);
 
-  bool get(char& c);
+  // Returns the unread part of the current source up to and including the
+  // next new-line (or the end of the source), and marks it as read.
+  // Reading a source switches to an included one as soon as the directive 
+  // is handled, so callers must come back for the next line rather than
+  // read ahead.
+  bool getLine(const char*& begin, const char*& end);
   void include(const std::string& source);
   const std::string& file() const {
-    CHECK(!names_.empty());
-    return names_.back();
+    CHECK(!sources_.empty());
+    return sources_.back()->name;
   }
   std::string& file() {
-    CHECK(!names_.empty());
-    return names_.back();
+    CHECK(!sources_.empty());
+    return sources_.back()->name;
   }
   size_t line() const {
-    CHECK(!lines_.empty());
-    return lines_.back();
+    CHECK(!sources_.empty());
+    return sources_.back()->getLine();
   }
   size_t& line() {
-    CHECK(!lines_.empty());
-    return lines_.back();
+    CHECK(!sources_.empty());
+    return sources_.back()->syncLine();
   }
   void pragmaOnce(const std::string& source);
+  // skip the rest of a skipped group in the current source up to the line of
+  // the #elif, #else or #endif which ends it (see SkipScanner)
+  void skipGroup();
 private:
+  struct Source {
+    explicit Source(const std::string& _name) : name(_name) { }
+    ~Source();
+    void setData(const char* _begin, const char* _end) {
+      begin = pos = linePos = _begin;
+      end = _end;
+    }
+    // lines are counted lazily, up to the read position
+    size_t getLine() const;
+    size_t& syncLine();
+
+    std::string name;
+    // the contents if they are not mapped
+    std::string data;
+    void* mapped { nullptr };
+    size_t mappedSize { 0 };
+
+    const char* begin { nullptr };
+    const char* end { nullptr };
+    const char* pos { nullptr };
+
+    // the line number at linePos
+    const char* linePos { nullptr };
+    size_t line { 1 };
+    // whether the character read before linePos was a new-line
+    bool previousIsNewLine { false };
+  };
+
   void open(const std::string& name);
   void open(std::istream& in, const std::string& name);
+  void push(std::unique_ptr<Source>&& source);
+  // pop the sources which have been read entirely; false if none is left
+  bool popFinished();
   std::string getPathRel(const std::string& source) const;
 
-  std::vector<std::pair<std::string, size_t>> sources_;
-  std::vector<std::string> names_;
-  std::vector<size_t> lines_;
-  bool previousIsNewLine_ { false };
+  std::vector<std::unique_ptr<Source>> sources_;
   std::set<PA5FileId> pragmaOnced_;
 };
 
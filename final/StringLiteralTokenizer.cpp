@@ -53,11 +53,11 @@ void readString(const PPToken& token,
                 int quote,
                 vector<int>& codePoints)
 {
-  auto it = token.data.begin() + start;
+  auto it = token.data().begin() + start;
   CHECK(*it == quote);
   ++it;
-  while (it < token.data.end() && *it != quote) {
-    int code = Utf8Utils::getEscapedCodePoint(it, token.data.end());
+  while (it < token.data().end() && *it != quote) {
+    int code = Utf8Utils::getEscapedCodePoint(it, token.data().end());
     if (!Utf8Utils::isValidUnicode(code)) {
       Throw("{x} is not a valid unicode point from {}", 
             code,
@@ -66,7 +66,7 @@ void readString(const PPToken& token,
     codePoints.push_back(code);
   }
 
-  CHECK(it < token.data.end());
+  CHECK(it < token.data().end());
 }
 
 void readRawString(const PPToken& token, 
@@ -74,7 +74,7 @@ void readRawString(const PPToken& token,
                 int quote,
                 vector<int>& codePoints)
 {
-  auto it = token.data.begin() + start;
+  auto it = token.data().begin() + start;
   CHECK(*it == quote);
   ++it;
   vector<int> dChar;
@@ -82,16 +82,16 @@ void readRawString(const PPToken& token,
     dChar.push_back(*it++);
   }
   ++it;
-  while (it < token.data.end()) {
+  while (it < token.data().end()) {
     if (*it == '"') {
-      if (Utf8Utils::dCharMatch(token.data.begin(), it, dChar)) {
+      if (Utf8Utils::dCharMatch(token.data().begin(), it, dChar)) {
         codePoints.erase(codePoints.end() - dChar.size() - 1, codePoints.end());
         break;
       }
     }
     codePoints.push_back(*it++);
   }
-  CHECK(it < token.data.end());
+  CHECK(it < token.data().end());
 } 
 
 }
@@ -116,7 +116,7 @@ void StringLiteralTokenizer::handle()
   for (int i = 0; i < n; ++i) {
     auto& token = tokens_[i];
     int start = 0;
-    string e = getEncoding(token.data, start);
+    string e = getEncoding(token.data(), start);
     string s = getSuffix(token, quote());
 
     if (!encoding.empty() && !e.empty() && encoding != e) {
@@ -136,7 +136,7 @@ void StringLiteralTokenizer::handle()
       suffix = s;
     }
 
-    if (token.data[start] == 'R') {
+    if (token.data()[start] == 'R') {
       readRawString(token, start + 1, quote(), codePoints);
     } else {
       readString(token, start, quote(), codePoints);
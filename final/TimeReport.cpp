@@ -0,0 +1,188 @@
+#include "TimeReport.h"
+#include "common.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace compiler {
+
+using namespace std;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+const char* const StageNames[] = {
+  "driver",
+  "source-reader",
+  "pp-tokenizer",
+  "preprocessor",
+  "tokenizer",
+  "parser",
+  "linker",
+  "cy86-compiler",
+};
+
+const char* const CounterNames[] = {
+  "bytes",
+  "lines",
+  "pp-tokens",
+  "tokens",
+  "allocations",
+  "macro-expansions",
+  "includes",
+  "backtracks",
+  "memo-hits",
+  "predictions",
+  "deferred-bodies",
+  "lookup-hits",
+  "fixups",
+};
+
+// plain arrays so that nothing here allocates or is destroyed before the
+// report is printed at exit. Counts may come from other threads of a stage
+// (see ParserOption::bodyThreads), and time from a TimeReport::Thread, so
+// they are atomic.
+bool json = false;
+atomic<Clock::rep> elapsed[TimeReport::NumStages];
+atomic<uint64_t> counts[TimeReport::NumStages][TimeReport::NumCounters];
+const int MaxDepth = 64;
+
+
+// the stages a thread is in, innermost last
+struct Track {
+  TimeReport::Stage stack[MaxDepth] = { TimeReport::Driver };
+  int depth = 0;
+  Clock::time_point last;
+};
+
+Track mainTrack;
+// that of a TimeReport::Thread
+thread_local Track threadTrack;
+// other threads count into the stage of the main one unless they have a
+// TimeReport::Thread
+thread_local Track* track = &mainTrack;
+
+void charge(Clock::time_point now)
+{
+  elapsed[track->stack[track->depth]].fetch_add((now - track->last).count(),
+                                                memory_order_relaxed);
+  track->last = now;
+}
+
+Clock::duration elapsedOf(int stage)
+{
+  return Clock::duration(elapsed[stage].load(memory_order_relaxed));
+}
+
+double ms(Clock::duration d)
+{
+  return chrono::duration<double, milli>(d).count();
+}
+
+}
+
+bool TimeReport::enabled_ = false;
+bool TimeReport::allocationsCounted_ = false;
+
+void TimeReport::parseCommandline(vector<string>& args)
+{
+  if (hasCommandlineSwitch(args, "--time-report")) {
+    enable(false);
+  }
+  if (hasCommandlineSwitch(args, "--time-report=json")) {
+    enable(true);
+  }
+}
+
+void TimeReport::enable(bool asJson)
+{
+  json = asJson;
+  if (!enabled_) {
+    enabled_ = true;
+    mainTrack.last = Clock::now();
+    atexit(print);
+  }
+}
+
+TimeReport::Thread::Thread()
+{
+  threadTrack = Track();
+  threadTrack.last = Clock::now();
+  track = &threadTrack;
+}
+
+TimeReport::Thread::~Thread()
+{
+  if (enabled_) {
+    charge(Clock::now());
+  }
+  track = &mainTrack;
+}
+
+void TimeReport::enter(Stage stage)
+{
+  CHECK(track->depth + 1 < MaxDepth);
+  charge(Clock::now());
+  track->stack[++track->depth] = stage;
+}
+
+void TimeReport::leave()
+{
+  charge(Clock::now());
+  --track->depth;
+}
+
+void TimeReport::add(Counter counter, uint64_t n)
+{
+  counts[track->stack[track->depth]][counter].fetch_add(n,
+                                                        memory_order_relaxed);
+}
+
+void TimeReport::print()
+{
+  charge(Clock::now());
+  enabled_ = false;
+
+  Clock::duration total { 0 };
+  for (int s = 0; s < NumStages; ++s) {
+    total += elapsedOf(s);
+  }
+
+  ostream& out = cerr;
+  if (json) {
+    out << "{\"total_ms\": " << ms(total) << ", \"stages\": {";
+    const char* sep = "";
+    for (int s = 0; s < NumStages; ++s) {
+      out << sep << "\"" << StageNames[s] << "\": {\"wall_ms\": "
+          << ms(elapsedOf(s));
+      for (int c = 0; c < NumCounters; ++c) {
+        if (c != Allocations || allocationsCounted_) {
+          out << ", \"" << CounterNames[c] << "\": " << counts[s][c];
+        }
+      }
+      out << "}";
+      sep = ", ";
+    }
+    out << "}}" << endl;
+    return;
+  }
+
+  out << "time report (wall ms)" << endl;
+  for (int s = 0; s < NumStages; ++s) {
+    out << "  " << left << setw(16) << StageNames[s]
+        << right << setw(10) << fixed << setprecision(2) << ms(elapsedOf(s));
+    for (int c = 0; c < NumCounters; ++c) {
+      if (counts[s][c]) {
+        out << "  " << CounterNames[c] << "=" << counts[s][c];
+      }
+    }
+    out << endl;
+  }
+  out << "  " << left << setw(16) << "total"
+      << right << setw(10) << fixed << setprecision(2) << ms(total) << endl;
+}
+
+}
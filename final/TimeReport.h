@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace compiler {
+
+// Wall time and event counts per pipeline stage, printed to stderr when a
+// driver is run with --time-report (or --time-report=json). Unless enabled,
+// every hook is a test of a single flag. Allocations are only counted, and
+// reported, in builds made with TIME_REPORT_ALLOCS.
+class TimeReport
+{
+public:
+  enum Stage {
+    Driver,
+    SourceReader,
+    PPTokenizer,
+    Preprocessor,
+    Tokenizer,
+    Parser,
+    Linker,
+    Cy86Compiler,
+    NumStages
+  };
+
+  enum Counter {
+    Bytes,
+    Lines,
+    PPTokens,
+    Tokens,
+    Allocations,
+    MacroExpansions,
+    Includes,
+    Backtracks,
+    MemoHits,
+    Predictions,
+    DeferredBodies,
+    LookupHits,
+    Fixups,
+    NumCounters
+  };
+
+  // Charges the time spent while alive, and anything counted meanwhile, to
+  // a stage. A nested Scope pauses the enclosing one.
+  class Scope
+  {
+  public:
+    explicit Scope(Stage stage) : active_(enabled_) {
+      if (active_) {
+        enter(stage);
+      }
+    }
+    ~Scope() {
+      if (active_) {
+        leave();
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  private:
+    bool active_;
+  };
+
+  // Gives the thread it lives on stages of its own, starting at Driver,
+  // for the time it runs alongside the main one. The time of both is
+  // charged, so the stages then add up to more than the wall time.
+  class Thread
+  {
+  public:
+    Thread();
+    ~Thread();
+    Thread(const Thread&) = delete;
+    Thread& operator=(const Thread&) = delete;
+  };
+
+  // removes the switches from args; the report is printed at exit
+  static void parseCommandline(std::vector<std::string>& args);
+  static void enable(bool json);
+  static bool enabled() { return enabled_; }
+  static void count(Counter counter, uint64_t n = 1) {
+    if (enabled_) {
+      add(counter, n);
+    }
+  }
+private:
+  static void enter(Stage stage);
+  static void leave();
+  static void add(Counter counter, uint64_t n);
+  static void print();
+
+  static bool enabled_;
+  // set by TimeReportAllocs.cpp when it is linked in
+  static bool allocationsCounted_;
+  friend struct CountAllocations;
+};
+
+}
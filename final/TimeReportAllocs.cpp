@@ -0,0 +1,40 @@
+#include "TimeReport.h"
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocator to count the allocations of each stage.
+// This costs every allocation a test even with the report off, so only
+// builds made with TIME_REPORT_ALLOCS link it (see the Makefile).
+
+namespace compiler {
+
+struct CountAllocations {
+  CountAllocations() {
+    TimeReport::allocationsCounted_ = true;
+  }
+};
+
+static CountAllocations countAllocations;
+
+}
+
+// counts the allocations of the current stage
+void* operator new(size_t n)
+{
+  compiler::TimeReport::count(compiler::TimeReport::Allocations);
+  for (;;) {
+    if (void* p = malloc(n ? n : 1)) {
+      return p;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (!handler) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void operator delete(void* p) noexcept
+{
+  free(p);
+}
@@ -130,6 +130,18 @@ struct TokenSimple : public Token
   ETokenType type;
 };
 
+// A simple token or identifier as the tokenizer hands it to a receiver
+// that stores tokens by spelling (see TokenReceiver): the spelling is the
+// id of the pp-token's spelling in ppToken::Spellings, so no Token needs
+// building and no text copying.
+struct SpelledToken
+{
+  TokenType type;
+  // meaningful for simple tokens only
+  ETokenType simpleType;
+  uint32_t spelling;
+};
+
 template<typename T>
 struct TypedHexDump {
   std::string operator()(const T& data) {
@@ -224,7 +236,7 @@ struct LiteralTypeTraits {
   using TElement = T;
 
   SType getType(const T&) const {
-    return std::make_shared<FundalmentalType>(FundamentalTypeOf<T>());
+    return FundalmentalType::get(FundamentalTypeOf<T>());
   }
 
   // not used
@@ -237,7 +249,7 @@ struct LiteralTypeTraits<std::string> {
 
   SType getType(const std::string& v) const {
     auto type = std::make_shared<ArrayType>(v.size());
-    auto element = LiteralTypeTraits<char>().getType(char{});
+    auto element = LiteralTypeTraits<char>().getType(char{})->clone();
     element->setCvQualifier(CvQualifier::Const);
     type->setDepended(element);
     return type;
@@ -254,7 +266,7 @@ struct LiteralTypeTraits<std::vector<T>> {
 
   SType getType(const std::vector<T>& v) const {
     auto type = std::make_shared<ArrayType>(v.size());
-    auto element = LiteralTypeTraits<T>().getType(T{});
+    auto element = LiteralTypeTraits<T>().getType(T{})->clone();
     element->setCvQualifier(CvQualifier::Const);
     type->setDepended(element);
     return type;
@@ -0,0 +1,123 @@
+#include "TokenBuffer.h"
+#include "preprocessing_token/PreprocessingToken.h"
+
+namespace compiler {
+
+using namespace std;
+
+void TokenBuffer::push_back(const Token& token)
+{
+  TokenType kind = token.getType();
+  if (kind == TokenType::Eof || kind == TokenType::NewLine) {
+    static const string none;
+    push(kind, ETokenType(), &none, NotKept);
+    return;
+  }
+  ETokenType simpleType = ETokenType();
+  if (kind == TokenType::Simple) {
+    simpleType = static_cast<const TokenSimple&>(token).type;
+  }
+  uint32_t payload = keptBegin_ + static_cast<uint32_t>(kept_.size());
+  kept_.push_back(token.copy());
+  push(kind, simpleType, &kept_.back()->source, payload);
+}
+
+void TokenBuffer::push_back(const SpelledToken& token)
+{
+  push(token.type,
+       token.simpleType,
+       &ppToken::Spellings::u8(token.spelling),
+       NotKept);
+}
+
+void TokenBuffer::pushSimple(const string& source, ETokenType type)
+{
+  push_back(SpelledToken { TokenType::Simple,
+                           type,
+                           ppToken::Spellings::intern(source) });
+}
+
+void TokenBuffer::push(TokenType kind,
+                       ETokenType simpleType,
+                       const string* spelling,
+                       uint32_t payload)
+{
+  kinds_.push_back(kind);
+  simpleTypes_.push_back(simpleType);
+  spellings_.push_back(spelling);
+  payloads_.push_back(payload);
+}
+
+void TokenBuffer::append(TokenBuffer&& tokens)
+{
+  CHECK(tokens.begin_ == 0);
+  // the kept tokens move, but not the text their spellings point at
+  uint32_t keptBase = keptBegin_ + static_cast<uint32_t>(kept_.size());
+  for (size_t i = 0; i < tokens.kinds_.size(); ++i) {
+    uint32_t payload = tokens.payloads_[i];
+    push(tokens.kinds_[i],
+         tokens.simpleTypes_[i],
+         tokens.spellings_[i],
+         payload == NotKept ? NotKept : keptBase + payload);
+  }
+  for (auto& token : tokens.kept_) {
+    kept_.push_back(move(token));
+  }
+}
+
+void TokenBuffer::dropBefore(size_t begin)
+{
+  CHECK(begin_ <= begin && begin <= size());
+  size_t n = begin - begin_;
+  if (n < minDrop_ || n < kinds_.size() / 2) {
+    return;
+  }
+  uint32_t firstKept = keptBegin_ + static_cast<uint32_t>(kept_.size());
+  for (size_t i = n; i < kinds_.size(); ++i) {
+    if (payloads_[i] != NotKept) {
+      firstKept = payloads_[i];
+      break;
+    }
+  }
+  kept_.erase(kept_.begin(), kept_.begin() + (firstKept - keptBegin_));
+  keptBegin_ = firstKept;
+  kinds_.erase(kinds_.begin(), kinds_.begin() + n);
+  simpleTypes_.erase(simpleTypes_.begin(), simpleTypes_.begin() + n);
+  spellings_.erase(spellings_.begin(), spellings_.begin() + n);
+  payloads_.erase(payloads_.begin(), payloads_.begin() + n);
+  begin_ = begin;
+}
+
+string TokenBuffer::toStr(size_t i) const
+{
+  switch (kind(i)) {
+    case TokenType::Eof:
+      return "eof";
+    case TokenType::NewLine:
+      return "<new-line>";
+    case TokenType::Literal:
+      return literal(i).toStr();
+    case TokenType::Simple:
+      return format("simple {} {}",
+                    source(i),
+                    getSimpleTokenTypeName(simpleType(i)));
+    case TokenType::Identifier:
+      return format("identifier {}", source(i));
+    default:
+      return format("invalid {}", source(i));
+  }
+}
+
+string TokenBuffer::toSimpleStr(size_t i) const
+{
+  switch (kind(i)) {
+    case TokenType::Simple:
+      return getSimpleTokenTypeName(simpleType(i));
+    case TokenType::Identifier:
+      return source(i);
+    default:
+      return toStr(i);
+  }
+}
+
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include "Token.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace compiler {
+
+class TokenRef;
+
+// The tokens a parser runs over, stored column by column: the kind, simple
+// token type and spelling of every token are plain arrays, so looking ahead
+// is a load rather than a virtual call on a heap object. A token pushed by
+// spelling points at its text in ppToken::Spellings, which is looked up
+// when it is pushed, on the thread that interns; a Token pushed whole is
+// kept whole, in a side table, for a literal's typed payload or for text
+// that was never interned. There is no source location to keep: Token does
+// not carry one.
+//
+// A buffer may also be read while it is filled: a parser asks for the
+// tokens it is about to look at with ensure(), which gets them from the
+// buffer's Source, and tells it with release() which ones it will not look
+// at again, which the Source may then drop. Both change the buffer, so a
+// parser that reads as it goes holds it non-const. Indices stay those of
+// the whole token stream.
+class TokenBuffer
+{
+public:
+  class Source
+  {
+  public:
+    virtual ~Source() { }
+    // appends tokens to the buffer until it has end of them; false if the
+    // stream ends first
+    virtual bool fill(size_t end) = 0;
+    virtual void release(size_t begin) = 0;
+  };
+
+  TokenBuffer() = default;
+  TokenBuffer(const TokenBuffer&) = delete;
+  TokenBuffer& operator=(const TokenBuffer&) = delete;
+  TokenBuffer(TokenBuffer&&) = default;
+  TokenBuffer& operator=(TokenBuffer&&) = default;
+
+  void push_back(const Token& token);
+  void push_back(const SpelledToken& token);
+  // source must be ASCII
+  void pushSimple(const std::string& source, ETokenType type);
+  // moves the tokens of a buffer nothing was dropped from to the end
+  void append(TokenBuffer&& tokens);
+
+  void setSource(Source* source) { source_ = source; }
+  // dropBefore() leaves fewer tokens than this where they are
+  void setMinDrop(size_t n) { minDrop_ = n; }
+  // true if there is a token i, after filling the buffer up to it
+  bool ensure(size_t i) {
+    return i < size() || (source_ && source_->fill(i + 1));
+  }
+  // the tokens before begin are not needed any more
+  void release(size_t begin) {
+    if (source_) {
+      source_->release(begin);
+    }
+  }
+  // Forgets the tokens before begin, which only happens once they are
+  // most of those kept and at least minDrop, so that every token is moved
+  // a bounded number of times. For the Source.
+  void dropBefore(size_t begin);
+
+  // one past the last token there is
+  size_t size() const { return begin_ + kinds_.size(); }
+  bool empty() const { return kinds_.empty(); }
+  inline TokenRef operator[](size_t i) const;
+
+  TokenType kind(size_t i) const { return kinds_[i - begin_]; }
+  // meaningful for simple tokens only
+  ETokenType simpleType(size_t i) const { return simpleTypes_[i - begin_]; }
+  const std::string& source(size_t i) const {
+    return *spellings_[i - begin_];
+  }
+  const TokenLiteralBase& literal(size_t i) const {
+    CHECK(kind(i) == TokenType::Literal);
+    return static_cast<const TokenLiteralBase&>(
+             *kept_[payloads_[i - begin_] - keptBegin_]);
+  }
+
+  bool isSimple(size_t i) const { return kind(i) == TokenType::Simple; }
+  bool isSimple(size_t i, ETokenType type) const {
+    return isSimple(i) && simpleType(i) == type;
+  }
+  bool isIdentifier(size_t i) const {
+    return kind(i) == TokenType::Identifier;
+  }
+  bool isLiteral(size_t i) const { return kind(i) == TokenType::Literal; }
+  bool isEof(size_t i) const { return kind(i) == TokenType::Eof; }
+  // as Token::isEmptyStr and Token::isZero
+  bool isEmptyStr(size_t i) const {
+    return isLiteral(i) && source(i) == "\"\"";
+  }
+  bool isZero(size_t i) const {
+    return isLiteral(i) && source(i) == "0";
+  }
+
+  // as Token::toStr and Token::toSimpleStr
+  std::string toStr(size_t i) const;
+  std::string toSimpleStr(size_t i) const;
+
+private:
+  // the payload of a token that is not kept whole
+  static const uint32_t NotKept = UINT32_MAX;
+
+  void push(TokenType kind,
+            ETokenType simpleType,
+            const std::string* spelling,
+            uint32_t payload);
+
+  // the index of the first token there is
+  size_t begin_ { 0 };
+  std::vector<TokenType> kinds_;
+  std::vector<ETokenType> simpleTypes_;
+  // equal spellings of tokens pushed by spelling are the same string
+  std::vector<const std::string*> spellings_;
+  // the number of a token among those of the stream kept whole, or NotKept
+  std::vector<uint32_t> payloads_;
+  // those from the number keptBegin_ on
+  std::vector<UToken> kept_;
+  uint32_t keptBegin_ { 0 };
+  Source* source_ { nullptr };
+  size_t minDrop_ { 1 << 16 };
+};
+
+// A token of a TokenBuffer, answering the questions a Token would
+class TokenRef
+{
+public:
+  TokenRef(const TokenBuffer& buffer, size_t index)
+    : buffer_(&buffer),
+      index_(index) { }
+
+  size_t index() const { return index_; }
+  TokenType getType() const { return buffer_->kind(index_); }
+  ETokenType simpleType() const { return buffer_->simpleType(index_); }
+  const std::string& source() const { return buffer_->source(index_); }
+  const TokenLiteralBase& literal() const { return buffer_->literal(index_); }
+
+  bool isSimple() const { return buffer_->isSimple(index_); }
+  bool isIdentifier() const { return buffer_->isIdentifier(index_); }
+  bool isLiteral() const { return buffer_->isLiteral(index_); }
+  bool isEof() const { return buffer_->isEof(index_); }
+  bool isEmptyStr() const { return buffer_->isEmptyStr(index_); }
+  bool isZero() const { return buffer_->isZero(index_); }
+
+  std::string toStr() const { return buffer_->toStr(index_); }
+  std::string toSimpleStr() const { return buffer_->toSimpleStr(index_); }
+
+private:
+  const TokenBuffer* buffer_;
+  size_t index_;
+};
+
+TokenRef TokenBuffer::operator[](size_t i) const
+{
+  return TokenRef(*this, i);
+}
+
+// Passes a token of the preprocessor on to tokens, a TokenBuffer or a
+// TokenPipe, as a parser wants it: without new lines, and with >> split in
+// two, so that it can close two template argument lists.
+// TODO: consider moving this transformation stage to Parser
+template<typename Tokens>
+void postToken(Tokens& tokens, const Token& token) {
+  if (token.isSimple()) {
+    if (static_cast<const TokenSimple&>(token).type == OP_RSHIFT) {
+      tokens.pushSimple(">", OP_RSHIFT_1);
+      tokens.pushSimple(">", OP_RSHIFT_2);
+      return;
+    }
+  } else if (token.isNewLine()) {
+    return;
+  }
+  tokens.push_back(token);
+}
+
+// the same for a token passed by spelling, which is never a new line
+template<typename Tokens>
+void postToken(Tokens& tokens, const SpelledToken& token) {
+  if (token.type == TokenType::Simple && token.simpleType == OP_RSHIFT) {
+    tokens.pushSimple(">", OP_RSHIFT_1);
+    tokens.pushSimple(">", OP_RSHIFT_2);
+    return;
+  }
+  tokens.push_back(token);
+}
+
+}
@@ -0,0 +1,96 @@
+#include "TokenPipe.h"
+
+namespace compiler {
+
+using namespace std;
+
+TokenPipe::TokenPipe(TokenBuffer& tokens)
+  : tokens_(tokens),
+    queue_(QueuedBatches)
+{
+  tokens_.setSource(this);
+}
+
+TokenPipe::~TokenPipe()
+{
+  tokens_.setSource(nullptr);
+}
+
+void TokenPipe::push_back(const Token& token)
+{
+  batch_.push_back(token);
+  if (batch_.size() == BatchSize) {
+    flush();
+  }
+}
+
+void TokenPipe::push_back(const SpelledToken& token)
+{
+  batch_.push_back(token);
+  if (batch_.size() == BatchSize) {
+    flush();
+  }
+}
+
+void TokenPipe::pushSimple(const string& source, ETokenType type)
+{
+  batch_.pushSimple(source, type);
+  if (batch_.size() == BatchSize) {
+    flush();
+  }
+}
+
+void TokenPipe::flush()
+{
+  if (!cancelled_ && !queue_.push(move(batch_))) {
+    cancelled_ = true;
+  }
+  batch_ = TokenBuffer();
+}
+
+void TokenPipe::close()
+{
+  flush();
+  queue_.close();
+}
+
+void TokenPipe::fail(exception_ptr error)
+{
+  error_ = error;
+  queue_.close();
+}
+
+bool TokenPipe::fill(size_t end)
+{
+  TokenBuffer batch;
+  while (tokens_.size() < end && !ended_) {
+    if (queue_.pop(batch)) {
+      tokens_.append(move(batch));
+      continue;
+    }
+    ended_ = true;
+    if (error_) {
+      tokens_.push_back(TokenEof());
+    }
+  }
+  return tokens_.size() >= end;
+}
+
+void TokenPipe::release(size_t begin)
+{
+  tokens_.dropBefore(begin);
+}
+
+void TokenPipe::cancel()
+{
+  queue_.close();
+}
+
+void TokenPipe::rethrow() const
+{
+  if (error_) {
+    rethrow_exception(error_);
+  }
+}
+
+}
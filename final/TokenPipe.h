@@ -0,0 +1,52 @@
+#pragma once
+#include "BoundedQueue.h"
+#include "TokenBuffer.h"
+#include <exception>
+#include <string>
+
+namespace compiler {
+
+// Carries tokens from a preprocessor on one thread to a parser on another:
+// the preprocessor pushes them into batches, which go through a bounded
+// queue, and the parser's reads of the buffer the pipe is the Source of
+// take them from there. The tokens the parser released are dropped, so
+// neither the queue nor the buffer grows with the translation unit.
+class TokenPipe : public TokenBuffer::Source
+{
+public:
+  static const size_t BatchSize = 4096;
+  static const size_t QueuedBatches = 8;
+
+  explicit TokenPipe(TokenBuffer& tokens);
+  ~TokenPipe();
+  TokenPipe(const TokenPipe&) = delete;
+  TokenPipe& operator=(const TokenPipe&) = delete;
+
+  // the producer's side; after cancel() the tokens are dropped
+  void push_back(const Token& token);
+  void push_back(const SpelledToken& token);
+  void pushSimple(const std::string& source, ETokenType type);
+  void close();
+  // ends the stream, which then has an eof for the parser to stop at
+  void fail(std::exception_ptr error);
+
+  // the consumer's side
+  bool fill(size_t end) override;
+  void release(size_t begin) override;
+  // the parser is done with the tokens
+  void cancel();
+  // the error the producer failed with, if any; once it is done
+  void rethrow() const;
+
+private:
+  void flush();
+
+  TokenBuffer& tokens_;
+  TokenBuffer batch_;
+  BoundedQueue<TokenBuffer> queue_;
+  bool cancelled_ { false };
+  std::exception_ptr error_;
+  bool ended_ { false };
+};
+
+}
@@ -607,11 +607,11 @@ std::string getSuffix(const ppToken::PPToken& token, int quote)
   if (!token.isUserDefined()) {
     return "";
   } else {
-    auto it = std::find(token.data.rbegin(), 
-                   token.data.rend(),
+    auto it = std::find(token.data().rbegin(), 
+                   token.data().rend(),
                    quote);
-    CHECK(it != token.data.rend());
-    std::vector<int> suffix(it.base(), token.data.end());
+    CHECK(it != token.data().rend());
+    std::vector<int> suffix(it.base(), token.data().end());
     CHECK(!suffix.empty());
     std::string strSuffix = Utf8Encoder::encode(suffix);
     if (strSuffix[0] != '_') {
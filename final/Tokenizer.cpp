@@ -2,18 +2,78 @@
 #include "Tokenizer.h"
 #include "TokenUtils.h"
 #include "Token.h"
+#include "Trie.h"
+#include "TimeReport.h"
 
 namespace compiler {
 
 using namespace std;
 using namespace ppToken;
 
+namespace {
+
+const int16_t Unclassified = -2;
+const int16_t NotSimple = -1;
+
+// keywords and punctuators of StringToTokenTypeMap in one flat trie
+class SimpleTokenTable {
+public:
+  SimpleTokenTable() : trie_(words()) { }
+  int16_t find(const string& s) const {
+    FlatTrie::State state = trie_.find(s.begin(), s.end());
+    if (state == FlatTrie::None || !trie_.leaf(state)) {
+      return NotSimple;
+    }
+    return static_cast<int16_t>(types_[trie_.word(state)]);
+  }
+private:
+  vector<string> words() {
+    vector<string> r;
+    for (const auto& kv : StringToTokenTypeMap) {
+      r.push_back(kv.first);
+      types_.push_back(kv.second);
+    }
+    return r;
+  }
+
+  vector<ETokenType> types_;
+  FlatTrie trie_;
+};
+
+}
+
+int Tokenizer::simpleType(const PPToken& token)
+{
+  if (token.spelling >= simpleTypes_.size()) {
+    simpleTypes_.resize(token.spelling + 1, Unclassified);
+  }
+  int16_t& type = simpleTypes_[token.spelling];
+  if (type == Unclassified) {
+    static const SimpleTokenTable table;
+    type = table.find(token.dataStrU8());
+  }
+  return type;
+}
+
 void Tokenizer::handleSimpleOrIdentifier(const PPToken& token)
 {
-  string x = token.dataStrU8();
-  auto it = StringToTokenTypeMap.find(x);
-  if (it != StringToTokenTypeMap.end()) {
-    receiver_.put(TokenSimple(x, it->second));
+  int type = simpleType(token);
+  if (receiver_.takesSpelled()) {
+    if (type != NotSimple) {
+      receiver_.put(SpelledToken { TokenType::Simple,
+                                   static_cast<ETokenType>(type),
+                                   token.spelling });
+      return;
+    } else if (token.type == PPTokenType::Identifier) {
+      receiver_.put(SpelledToken { TokenType::Identifier,
+                                   ETokenType(),
+                                   token.spelling });
+      return;
+    }
+  }
+  const string& x = token.dataStrU8();
+  if (type != NotSimple) {
+    receiver_.put(TokenSimple(x, static_cast<ETokenType>(type)));
   } else if (token.type == PPTokenType::Identifier) {
     receiver_.put(TokenIdentifier(x));
   } else {
@@ -23,6 +83,8 @@ void Tokenizer::handleSimpleOrIdentifier(const PPToken& token)
 
 void Tokenizer::put(const PPToken& token)
 {
+  TimeReport::Scope scope(TimeReport::Tokenizer);
+  TimeReport::count(TimeReport::Tokens);
   // printToken(token);
   try {
     if (token.type != PPTokenType::StringLiteral &&
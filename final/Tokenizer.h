@@ -6,6 +6,8 @@
 #include "StringLiteralTokenizer.h"
 #include "FloatLiteralTokenizer.h"
 #include "IntegerLiteralTokenizer.h"
+#include <vector>
+#include <cstdint>
 
 namespace compiler {
 
@@ -21,6 +23,7 @@ public:
   void put(const PPToken& token);
 private:
   void handleSimpleOrIdentifier(const PPToken& token);
+  int simpleType(const PPToken& token);
 	TokenReceiver receiver_;
   CharLiteralTokenizer charLiteralPT_ {receiver_};
   StringLiteralTokenizer strLiteralPT_ {receiver_};
@@ -28,6 +31,8 @@ private:
   IntegerLiteralTokenizer intLiteralPT_ {receiver_};
 
   bool noStrCatForNewLine_;
+  // ETokenType of each spelling seen so far, indexed by spelling id
+  std::vector<int16_t> simpleTypes_;
 };
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Namespace.h"
+#include "TypeContext.h"
 #include <deque>
+#include <string>
+#include <unordered_map>
 
 namespace compiler {
 
@@ -10,7 +13,10 @@ class TranslationUnit {
   using VMember = std::vector<SMember>;
   using Frame = size_t;
 
-  TranslationUnit() {
+  // a context of its own unless given one to share
+  explicit TranslationUnit(STypeContext typeContext = nullptr)
+    : typeContext_(typeContext ? typeContext
+                               : std::make_shared<TypeContext>()) {
     globalNamespace_ = make_unique<Namespace>("", true, false, nullptr, this);
     openNamespace(&*globalNamespace_);
   }
@@ -49,12 +55,34 @@ class TranslationUnit {
     return members_;
   }
 
+  TypeContext& getTypeContext() const {
+    return *typeContext_;
+  }
+
+  // Lookup results cached by a Namespace stay valid while neither of
+  // these has moved on: the first with every using-directive added, the
+  // other with every member of the name.
+  uint64_t getLookupGeneration() const {
+    return lookupGeneration_;
+  }
+  void newLookupGeneration() {
+    ++lookupGeneration_;
+  }
+  // stays where it is as names are added
+  uint64_t* getNameGeneration(const std::string& name) {
+    return &nameGenerations_[name];
+  }
+
  private:
+  STypeContext typeContext_;
   UNamespace globalNamespace_;
   std::deque<Namespace*> namespaces_;
 
   // members of this translation unit in declaration order
   VMember members_;
+
+  uint64_t lookupGeneration_ { 0 };
+  std::unordered_map<std::string, uint64_t> nameGenerations_;
 };
 MakeUnique(TranslationUnit);
 
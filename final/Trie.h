@@ -1,50 +1,83 @@
 #pragma once
 
 #include "common.h"
-#include <map>
-#include <memory>
-#include <utility>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
 
 namespace compiler {
 
-class TrieNode;
-
-class TrieNode {
+// Immutable trie over ASCII strings laid out as one transition table.
+// Characters that occur in the words are numbered densely (0 means "not in
+// any word"), so a lookup is two array reads and the table for a few dozen
+// words fits in a couple of cache lines per state.
+class FlatTrie {
 public:
-  TrieNode* getOrCreateChild(int c) {
-    auto it = next_.find(c);
-    if (it != next_.end()) {
-      return it->second.get();
-    } else {
-      it = next_.insert(make_pair(c, make_unique<TrieNode>())).first;
-      return it->second.get();
+  typedef int State;
+  static const State Root = 0;
+  static const State None = -1;
+
+  explicit FlatTrie(const std::vector<std::string>& words) {
+    std::fill(class_, class_ + 128, 0);
+    for (const auto& s : words) {
+      for (char c : s) {
+        CHECK(static_cast<unsigned char>(c) < 128);
+        if (!class_[static_cast<unsigned char>(c)]) {
+          class_[static_cast<unsigned char>(c)] = static_cast<uint8_t>(width_++);
+        }
+      }
+    }
+    addState();
+    for (size_t w = 0; w < words.size(); ++w) {
+      const auto& s = words[w];
+      State n = Root;
+      for (char c : s) {
+        size_t i = n * width_ + class_[static_cast<unsigned char>(c)];
+        if (next_[i] == None) {
+          next_[i] = static_cast<int16_t>(addState());
+        }
+        n = next_[i];
+      }
+      word_[n] = static_cast<int>(w);
     }
   }
-  const TrieNode* getChild(int c) const {
-    auto it = next_.find(c);
-    return it == next_.end() ? nullptr : it->second.get();
-  }
-  bool& leaf() { return leaf_; }
-  bool leaf() const { return leaf_; }
-private:
-  std::map<int, std::unique_ptr<TrieNode>> next_;
-  bool leaf_;
-};
-
-class Trie {
-public:
-  const TrieNode* root() const {
-    return &root_;
+  State next(State s, int c) const {
+    if (c < 0 || c >= 128 || !class_[c]) {
+      return None;
+    }
+    return next_[s * width_ + class_[c]];
   }
-  void insert(const std::string& s) {
-    TrieNode* n = &root_;
-    for (char c : s) {
-      n = n->getOrCreateChild(c);
+  bool leaf(State s) const { return word_[s] >= 0; }
+  // index of the word ending at s, or -1
+  int word(State s) const { return word_[s]; }
+  // the state reached by walking [begin, end) from the root, or None
+  template<typename It>
+  State find(It begin, It end) const {
+    State s = Root;
+    for (It it = begin; it != end && s != None; ++it) {
+      s = next(s, *it);
     }
-    n->leaf() = true;
+    return s;
+  }
+  template<typename It>
+  bool contains(It begin, It end) const {
+    State s = find(begin, end);
+    return s != None && leaf(s);
   }
 private:
-  TrieNode root_;
+  State addState() {
+    CHECK(word_.size() < INT16_MAX);
+    next_.resize(next_.size() + width_, None);
+    word_.push_back(-1);
+    return static_cast<State>(word_.size() - 1);
+  }
+
+  uint8_t class_[128];
+  // class 0 is reserved for characters outside the alphabet
+  int width_ { 1 };
+  std::vector<int16_t> next_;
+  std::vector<int> word_;
 };
 
 }
@@ -22,16 +22,31 @@ string Type::getName() const {
 }
 
 bool Type::operator==(const Type& other) const {
-  return cvQualifier_ == other.cvQualifier_;
+  if (this == &other) {
+    return true;
+  }
+  if (internedWith(other)) {
+    return false;
+  }
+  return cvQualifier_ == other.cvQualifier_ && equalsUnqualified(other);
 }
 
 bool Type::equalsIgnoreCv(const Type& other) const {
-  // TODO: this can be made more efficient
-  auto a = clone();
-  auto b = other.clone();
-  a->setCvQualifier(CvQualifier::None);
-  b->setCvQualifier(CvQualifier::None);
-  return *a == *b;
+  return this == &other || equalsUnqualified(other);
+}
+
+bool Type::internedWith(const Type& other) const {
+  return interned_ && other.interned_ &&
+         (context_ == other.context_ || !context_ || !other.context_);
+}
+
+void Type::cacheLayout() {
+  // void has neither
+  if (!isVoid()) {
+    typeSize_ = computeTypeSize();
+    typeAlign_ = computeTypeAlign();
+    hasLayout_ = true;
+  }
 }
 
 SFundalmentalType Type::toFundalmental() {
@@ -178,7 +193,22 @@ void FundalmentalType::combine(const FundalmentalType& other) {
   setType();
 }
 
-size_t FundalmentalType::getTypeSize() const {
+const SFundalmentalType& FundalmentalType::get(EFundamentalType t) {
+  // built once, and never changed after
+  static const vector<SFundalmentalType> types = [] {
+    vector<SFundalmentalType> ret;
+    for (int i = 0; i <= FT_NULLPTR_T; ++i) {
+      auto type = make_shared<FundalmentalType>(EFundamentalType(i));
+      type->interned_ = true;
+      type->cacheLayout();
+      ret.push_back(type);
+    }
+    return ret;
+  }();
+  return types.at(t);
+}
+
+size_t FundalmentalType::computeTypeSize() const {
   return Sizes_.at(type_);
 }
 
@@ -307,11 +337,11 @@ void ArrayType::setCvQualifier(CvQualifier cvQualifier) {
   depended_->setCvQualifier(cvQualifier);
 }
 
-size_t ArrayType::getTypeSize() const {
+size_t ArrayType::computeTypeSize() const {
   return size_ * depended_->getTypeSize();
 }
 
-size_t ArrayType::getTypeAlign() const {
+size_t ArrayType::computeTypeAlign() const {
   return depended_->getTypeAlign();
 }
 
@@ -331,16 +361,23 @@ SPointerType ArrayType::toPointer() const {
   return ret;
 }
 
-bool ArrayType::operator==(const Type& rhs) const {
-  if (!DependentType::operator==(rhs)) {
+bool ArrayType::equalsUnqualified(const Type& rhs) const {
+  if (!DependentType::equalsUnqualified(rhs)) {
     return false;
   }
   auto& other = static_cast<const ArrayType&>(rhs);
   return size_ == other.size_;
 }
 
+bool ArrayType::equalsIgnoreCv(const Type& rhs) const {
+  auto other = dynamic_cast<const ArrayType*>(&rhs);
+  return other &&
+         size_ == other->size_ &&
+         depended_->equalsIgnoreCv(*other->depended_);
+}
+
 bool ArrayType::addSizeTo(const ArrayType& other) const {
-  if (!DependentType::operator==(other)) {
+  if (!DependentType::equalsUnqualified(other)) {
     return false;
   }
   return size_ && !other.size_;
@@ -397,7 +434,11 @@ FunctionType::FunctionType(std::vector<SType>&& params, bool hasVarArgs)
       p = pointer;
     }
     // TODO: need a way to preserve cv-qualifiers for function definition use
-    p->setCvQualifier(CvQualifier::None);
+    if (p->getCvQualifier() != CvQualifier::None) {
+      // p may be the type of a typedef
+      p = p->clone();
+      p->setCvQualifier(CvQualifier::None);
+    }
   }
 }
 
@@ -438,8 +479,8 @@ bool FunctionType::sameParameterAndQualifier(const FunctionType& other) const {
   return hasVarArgs_ == other.hasVarArgs_;
 }
 
-bool FunctionType::operator==(const Type& rhs) const {
-  if (!DependentType::operator==(rhs)) {
+bool FunctionType::equalsUnqualified(const Type& rhs) const {
+  if (!DependentType::equalsUnqualified(rhs)) {
     return false;
   }
   return sameParameterAndQualifier(static_cast<const FunctionType&>(rhs));
@@ -58,10 +58,18 @@ class PointerType;
 MakeShared(PointerType);
 class ReferenceType;
 MakeShared(ReferenceType);
+class TypeContext;
 
 // note: public inheritance is required
 class Type : public std::enable_shared_from_this<Type> {
  public:
+  Type() = default;
+  // a copy is not interned, whatever the original was
+  Type(const Type& other)
+    : std::enable_shared_from_this<Type>(other),
+      cvQualifier_(other.cvQualifier_) {
+  }
+
   std::string getName() const;
 
   // type manipulators to support parsing
@@ -71,8 +79,9 @@ class Type : public std::enable_shared_from_this<Type> {
     cvQualifier_ = cvQualifier;
   }
 
-  virtual bool operator==(const Type& other) const = 0;
-  bool equalsIgnoreCv(const Type& other) const;
+  // a pointer compare for two types interned by the same TypeContext
+  bool operator==(const Type& other) const;
+  virtual bool equalsIgnoreCv(const Type& other) const;
   bool operator!=(const Type& other) const {
     return !(*this == other);
   }
@@ -103,9 +112,12 @@ class Type : public std::enable_shared_from_this<Type> {
   SPointerType toPointer();
   SReferenceType toReference();
 
-  virtual size_t getTypeSize() const = 0;
-  virtual size_t getTypeAlign() const { 
-    return getTypeSize();
+  // cached on interned types
+  size_t getTypeSize() const {
+    return hasLayout_ ? typeSize_ : computeTypeSize();
+  }
+  size_t getTypeAlign() const {
+    return hasLayout_ ? typeAlign_ : computeTypeAlign();
   }
 
   void outputCvQualifier(std::ostream& out) const {
@@ -115,8 +127,31 @@ class Type : public std::enable_shared_from_this<Type> {
     return cvQualifier_;
   }
 
+  // true for the types a TypeContext handed out, which must not be changed
+  bool isInterned() const { return interned_; }
+
+ protected:
+  // compares all but the cv-qualifiers of the type itself
+  virtual bool equalsUnqualified(const Type& other) const = 0;
+  virtual size_t computeTypeSize() const = 0;
+  virtual size_t computeTypeAlign() const {
+    return computeTypeSize();
+  }
+
  private:
+  friend class TypeContext;
+  friend class FundalmentalType;
+
+  bool internedWith(const Type& other) const;
+  void cacheLayout();
+
   CvQualifier cvQualifier_;
+  bool interned_ { false };
+  // null for the types of FundalmentalType::get, which every context uses
+  const TypeContext* context_ { nullptr };
+  bool hasLayout_ { false };
+  size_t typeSize_ { 0 };
+  size_t typeAlign_ { 0 };
 };
 
 inline std::ostream& operator<<(std::ostream& out, const Type& type) {
@@ -133,6 +168,9 @@ class FundalmentalType : public Type {
   FundalmentalType(const TypeSpecifiers& typeSpecifier);
   FundalmentalType(EFundamentalType t) : type_(t) { }
 
+  // the interned unqualified type, shared by everything that needs one
+  static const SFundalmentalType& get(EFundamentalType t);
+
   EFundamentalType getType() const { return type_; }
 
   void combine(const FundalmentalType& other);
@@ -147,14 +185,13 @@ class FundalmentalType : public Type {
   bool isInteger() const;
   bool isIntegral() const;
   bool isFloatingPoint() const;
-  size_t getTypeSize() const override;
-  bool operator==(const Type& rhs) const override {
-    if (!Type::operator==(rhs)) {
-      return false;
-    }
+
+ protected:
+  bool equalsUnqualified(const Type& rhs) const override {
     auto other = dynamic_cast<const FundalmentalType*>(&rhs);
     return other && type_ == other->type_;
   }
+  size_t computeTypeSize() const override;
 
  private:
   struct Compare {
@@ -181,17 +218,15 @@ class DependentType : public Type {
     return depended_;
   }
 
-  bool operator==(const Type& other) const override {
-    if (!Type::operator==(other)) {
-      return false;
-    }
+ protected:
+  friend class TypeContext;
+
+  bool equalsUnqualified(const Type& other) const override {
     if (typeid(*this) != typeid(other)) {
       return false;
     }
     return *depended_ == *static_cast<const DependentType&>(other).depended_;
   }
-
- protected:
   virtual void checkDepended(SType depended) const = 0;
   void outputDepended(std::ostream& out) const;
   SType depended_;
@@ -205,9 +240,9 @@ class PointerType : public DependentType {
 
   void output(std::ostream& out) const override;
   bool isPointer() const override { return true; }
-  size_t getTypeSize() const override { return 8; }
 
  protected:
+  size_t computeTypeSize() const override { return 8; }
   void checkDepended(SType depended) const override;
 };
 MakeShared(PointerType);
@@ -228,11 +263,15 @@ class ReferenceType : public DependentType {
   }
   void output(std::ostream& out) const override;
   bool isReference() const override { return true; }
-  size_t getTypeSize() const override { return 8; }
   void setDepended(SType depended) override;
   Kind getKind() const { return kind_; }
 
  protected:
+  bool equalsUnqualified(const Type& other) const override {
+    return DependentType::equalsUnqualified(other) &&
+           kind_ == static_cast<const ReferenceType&>(other).kind_;
+  }
+  size_t computeTypeSize() const override { return 8; }
   void checkDepended(SType depended) const override;
 
  private:
@@ -249,9 +288,8 @@ class ArrayType : public DependentType {
   void setCvQualifier(CvQualifier cvQualifier) override;
   void output(std::ostream& out) const override;
   bool isArray() const override { return true; }
-  size_t getTypeSize() const override;
-  size_t getTypeAlign() const override;
-  bool operator==(const Type& other) const override;
+  // ignores the cv-qualifiers of the element type
+  bool equalsIgnoreCv(const Type& other) const override;
 
   size_t getArraySize() const { return size_; }
   void setArraySize(size_t value) { size_ = value; }
@@ -264,6 +302,9 @@ class ArrayType : public DependentType {
   SType getElementType() const;
 
  protected:
+  bool equalsUnqualified(const Type& other) const override;
+  size_t computeTypeSize() const override;
+  size_t computeTypeAlign() const override;
   void checkDepended(SType depended) const override;
 
  private:
@@ -278,13 +319,17 @@ class FunctionType : public DependentType {
     return std::make_shared<FunctionType>(*this);
   }
   bool isFunction() const override { return true; }
-  // note: not used for now
-  size_t getTypeSize() const override { return 0; }
 
+  const std::vector<SType>& getParameters() const { return parameters_; }
+  bool hasVarArgs() const { return hasVarArgs_; }
   bool sameParameterAndQualifier(const FunctionType& other) const;
-  bool operator==(const Type& other) const override;
 
  protected:
+  friend class TypeContext;
+
+  bool equalsUnqualified(const Type& other) const override;
+  // note: not used for now
+  size_t computeTypeSize() const override { return 0; }
   void checkDepended(SType depended) const override;
   void output(std::ostream& out) const override;
 
@@ -0,0 +1,106 @@
+#include "TypeContext.h"
+#include <functional>
+
+namespace compiler {
+
+using namespace std;
+
+namespace {
+
+enum Kind {
+  Fundalmental,
+  Pointer,
+  Reference,
+  Array,
+  Function
+};
+
+int kindOf(const Type& type) {
+  if (type.isFundalmental()) {
+    return Fundalmental;
+  } else if (type.isPointer()) {
+    return Pointer;
+  } else if (type.isReference()) {
+    return Reference;
+  } else if (type.isArray()) {
+    return Array;
+  } else {
+    CHECK(type.isFunction());
+    return Function;
+  }
+}
+
+void hashCombine(size_t& seed, size_t value) {
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+}
+
+size_t TypeContext::KeyHash::operator()(const Key& key) const {
+  size_t seed = static_cast<size_t>(key.kind);
+  hashCombine(seed, key.cv);
+  hashCombine(seed, key.value);
+  hashCombine(seed, hash<const Type*>()(key.depended));
+  for (auto p : key.parameters) {
+    hashCombine(seed, hash<const Type*>()(p));
+  }
+  return seed;
+}
+
+SType TypeContext::intern(const SType& type) {
+  lock_guard<mutex> lock(mutex_);
+  return internLocked(type);
+}
+
+SType TypeContext::internLocked(const SType& type) {
+  if (type->interned_ && (type->context_ == this || !type->context_)) {
+    return type;
+  }
+
+  Key key { kindOf(*type), type->getCvQualifier().value, 0, nullptr, {} };
+  SType depended;
+  vector<SType> parameters;
+  if (key.kind == Fundalmental) {
+    auto ft = static_cast<const FundalmentalType&>(*type).getType();
+    if (key.cv == CvQualifier::None) {
+      return FundalmentalType::get(ft);
+    }
+    key.value = ft;
+  } else {
+    depended = internLocked(static_cast<DependentType&>(*type).depended_);
+    key.depended = depended.get();
+    if (key.kind == Reference) {
+      key.value = static_cast<ReferenceType&>(*type).getKind();
+    } else if (key.kind == Array) {
+      key.value = static_cast<ArrayType&>(*type).getArraySize();
+    } else if (key.kind == Function) {
+      auto& function = static_cast<FunctionType&>(*type);
+      key.value = function.hasVarArgs();
+      for (auto& p : function.getParameters()) {
+        parameters.push_back(internLocked(p));
+        key.parameters.push_back(parameters.back().get());
+      }
+    }
+  }
+
+  auto it = types_.find(key);
+  if (it != types_.end()) {
+    return it->second;
+  }
+
+  // the children of the copy are the interned ones
+  auto ret = type->clone();
+  if (depended) {
+    static_cast<DependentType&>(*ret).depended_ = depended;
+  }
+  if (key.kind == Function) {
+    static_cast<FunctionType&>(*ret).parameters_ = move(parameters);
+  }
+  ret->interned_ = true;
+  ret->context_ = this;
+  ret->cacheLayout();
+  types_.emplace(move(key), ret);
+  return ret;
+}
+
+}
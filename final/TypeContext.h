@@ -0,0 +1,52 @@
+#pragma once
+#include "Type.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace compiler {
+
+// Holds every distinct type (cv-qualifiers and array bounds included)
+// exactly once, so that two types interned by the same context are equal
+// iff they are the same object, and their size and alignment are worked
+// out once. Interned types must not be changed: whatever needs a different
+// type clones one first. Translation units handed to one Linker share its
+// context, which may intern from several threads.
+class TypeContext {
+ public:
+  TypeContext() = default;
+  TypeContext(const TypeContext&) = delete;
+  TypeContext& operator=(const TypeContext&) = delete;
+
+  // the interned type equal to type, which is left as it is
+  SType intern(const SType& type);
+
+ private:
+  struct Key {
+    int kind;
+    CvQualifier::Value cv;
+    // the fundamental type, reference kind, array bound or whether a
+    // function has var args
+    size_t value;
+    // interned, as are the parameters
+    const Type* depended;
+    std::vector<const Type*> parameters;
+
+    bool operator==(const Key& rhs) const {
+      return kind == rhs.kind && cv == rhs.cv && value == rhs.value &&
+             depended == rhs.depended && parameters == rhs.parameters;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  SType internLocked(const SType& type);
+
+  std::mutex mutex_;
+  std::unordered_map<Key, SType, KeyHash> types_;
+};
+MakeShared(TypeContext);
+
+}
@@ -43,11 +43,7 @@ int main()
                             &postTokenizer,
                             _1));
 
-		for (char c : input)
-		{
-			unsigned char code_unit = c;
-			ppTokenizer.process(code_unit);
-		}
+		ppTokenizer.process(input.data(), input.data() + input.size());
 
 		ppTokenizer.process(EndOfFile);
     cout << "eof" << endl;
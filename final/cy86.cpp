@@ -1,5 +1,6 @@
 #include "Preprocessor.h"
 #include "Cy86Compiler.h"
+#include "TimeReport.h"
 
 #include <vector>
 #include <string>
@@ -101,14 +102,16 @@ public:
   }
   void generate() {
     BuildEnv env;
-    vector<UToken> tokens;
+    TokenBuffer tokens;
     for (auto& src : input_) {
       Preprocessor processor(env, src, [&tokens](const Token& token) {
         // TODO: fatal user defined literals (maybe in immediate)
         if (token.isNewLine()) {
           return;
         }
-        tokens.push_back(token.copy());
+        tokens.push_back(token);
+      }, [&tokens](const SpelledToken& token) {
+        tokens.push_back(token);
       });
       processor.process();
     }
@@ -154,6 +157,8 @@ int main(int argc, char** argv) {
     for (int i = 1; i < argc; i++)
       args.emplace_back(argv[i]);
 
+    TimeReport::parseCommandline(args);
+
     if (args.size() < 3 || args[0] != "-o")
       throw logic_error("invalid usage");
 
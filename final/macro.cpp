@@ -36,9 +36,8 @@ int main()
                        &ppDirective,
                        placeholders::_1));
 
-    for (char c; sourceReader.get(c); )
-    {
-      ppTokenizer.process(static_cast<unsigned char>(c));
+    for (const char* begin, *end; sourceReader.getLine(begin, end); ) {
+      ppTokenizer.process(begin, end);
     }
 
     ppTokenizer.process(EndOfFile);
@@ -1,5 +1,7 @@
 #include "BuildEnv.h"
 #include "common.h"
+#include "TimeReport.h"
+#include "RuleProfile.h"
 #include "Driver.h"
 #include <vector>
 #include <string>
@@ -10,6 +12,26 @@
 using namespace std;
 using namespace compiler;
 
+// --pipeline-drop=N pipelines and lets the parser drop as few as N tokens
+// at once, so that tests get to drop some
+void parsePipelineDropSwitch(vector<string>& args, ParserOption& option)
+{
+  const string prefix = "--pipeline-drop=";
+  for (auto it = args.begin(); it != args.end(); ) {
+    if (it->compare(0, prefix.size(), prefix) != 0) {
+      ++it;
+      continue;
+    }
+    int n = stoi(it->substr(prefix.size()));
+    if (n < 1) {
+      throw logic_error("invalid number of tokens to drop " + *it);
+    }
+    option.isPipelined = true;
+    option.minDroppedTokens = n;
+    it = args.erase(it);
+  }
+}
+
 int main(int argc, char** argv)
 {
   BuildEnv env;
@@ -20,10 +42,23 @@ int main(int argc, char** argv)
 		for (int i = 1; i < argc; i++)
 			args.emplace_back(argv[i]);
 
+    TimeReport::parseCommandline(args);
+    RuleProfile::parseCommandline(args);
+
     ParserOption option;
     if (hasCommandlineSwitch(args, "--trace")) {
       option.isTrace = true;
     }
+    if (hasCommandlineSwitch(args, "--bodies=deferred")) {
+      option.bodyMode = BodyMode::Deferred;
+    }
+    if (hasCommandlineSwitch(args, "--bodies=skip")) {
+      option.bodyMode = BodyMode::Skipped;
+    }
+    if (hasCommandlineSwitch(args, "--pipeline")) {
+      option.isPipelined = true;
+    }
+    parsePipelineDropSwitch(args, option);
 
 		if (args.size() < 3 || args[0] != "-o")
 			throw logic_error("invalid usage");
@@ -1,5 +1,6 @@
 #include "BuildEnv.h"
 #include "common.h"
+#include "TimeReport.h"
 #include "Driver.h"
 #include "Linker.h"
 #include <vector>
@@ -28,6 +29,8 @@ int main(int argc, char** argv)
 			args.emplace_back(argv[i]);
     }
 
+    TimeReport::parseCommandline(args);
+
     ParserOption option;
     if (hasCommandlineSwitch(args, "--trace")) {
       option.isTrace = true;
@@ -52,6 +55,7 @@ int main(int argc, char** argv)
     }
 
     Linker linker;
+    option.typeContext = linker.getTypeContext();
 		for (size_t i = 0; i < nsrcfiles; i++)
 		{
 			string srcFile = args[i + 2];
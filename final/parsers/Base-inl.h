@@ -34,6 +34,10 @@
  */
 #include "Declarator.h"
 #include "Expression.h"
+#include "RuleProfile.h"
+#include "TimeReport.h"
+#include "parsers/FunctionBodies.h"
+#include "parsers/ParseFailure.h"
 
 #include <type_traits>
 
@@ -56,8 +60,8 @@ namespace compiler {
     // an enable_if return type
     // This is probably a cleaner design anyways
 
-    template<typename F, typename... Args>
-    auto postActionCall(function<void()> postAction, F f, Args&&... args) ->
+    template<typename P, typename F, typename... Args>
+    auto postActionCall(P postAction, F f, Args&&... args) ->
       typename
       enable_if<
       !is_void<decltype(f(forward<Args>(args)...))>::value,
@@ -68,8 +72,8 @@ namespace compiler {
       return ret;
     }
 
-    template<typename F, typename... Args>
-    auto postActionCall(function<void()> postAction, F f, Args&&... args) ->
+    template<typename P, typename F, typename... Args>
+    auto postActionCall(P postAction, F f, Args&&... args) ->
       typename
       enable_if<
       is_void<decltype(f(forward<Args>(args)...))>::value,
@@ -81,40 +85,43 @@ namespace compiler {
     }
 
     struct Base {
-      static vector<UToken> emptyTokens_;
+      static TokenBuffer emptyTokens_;
 
       // To be used by intermediate sub-modules
       Base() : tokens_(emptyTokens_) {
       }
 
-      Base(const vector<UToken>& tokens, const ParserOption& option)
+      Base(TokenBuffer& tokens, const ParserOption& option)
         : tokens_(tokens),
         option_(option) {
-        translationUnit_ = make_unique<TranslationUnit>();
+        translationUnit_ = make_unique<TranslationUnit>(option.typeContext);
+        tokens_.ensure(1);
       }
 
       struct ParserState {
-        ParserState(size_t i)
-          : index(i) {}
+        ParserState(size_t i, size_t d)
+          : index(i), numDeferredBodies(d) {}
         size_t index;
+        size_t numDeferredBodies;
       };
 
+      // cheap enough to be on every rule call when not tracing
       class Trace {
       public:
         static const char* padding() {
           return "  ";
         }
         Trace(bool isTrace,
-              string&& name,
-              function<const Token& ()> curTokenGetter,
+              const char* name,
+              const Base* parser,
               int& traceDepth)
               : isTrace_(isTrace),
-              name_(move(name)),
-              curTokenGetter_(curTokenGetter),
+              name_(name),
+              parser_(parser),
               traceDepth_(traceDepth)  {
           if (isTrace_) {
             tracePadding();
-            cout << format("--> {} [{}]\n", name_, curTokenGetter_().toStr());
+            cout << format("--> {} [{}]\n", name_, parser_->cur().toStr());
             ++traceDepth_;
           }
         }
@@ -125,7 +132,7 @@ namespace compiler {
             cout << format("<-- {} {} [{}]\n",
                            name_,
                            ok_ ? "OK" : "BAD",
-                           curTokenGetter_().toStr());
+                           parser_->cur().toStr());
           }
         }
         void success() { ok_ = true; }
@@ -137,8 +144,8 @@ namespace compiler {
         }
 
         bool isTrace_;
-        string name_;
-        function<const Token& ()> curTokenGetter_;
+        const char* name_;
+        const Base* parser_;
         int& traceDepth_;
         bool ok_{ false };
       };
@@ -151,36 +158,48 @@ namespace compiler {
           cout << format("=== MATCH [{}]\n", cur().toStr());
         }
 
-        ++index_;
+        advanceTo(index_ + 1);
       }
 
-      const Token* get() const {
-        return &cur();
+      // with the token after the new one in the buffer too, for next()
+      void advanceTo(size_t index) {
+        index_ = index;
+        tokens_.ensure(index_ + 1);
       }
 
-      const Token* getAdv() {
+      TokenRef get() const {
+        return cur();
+      }
+
+      TokenRef getAdv() {
         auto r = get();
         adv();
         return r;
       }
 
-      const TokenSimple* getAdvSimple() {
-        return static_cast<const TokenSimple*>(getAdv());
+      ETokenType getAdvSimple() {
+        return getSimpleTokenType(getAdv());
       }
 
-      const Token& cur() const {
-        return *tokens_[index_];
+      TokenRef cur() const {
+        return tokens_[index_];
       }
 
       // We rarely need to look ahead 2 chars
       // but in certain cases we do
-      const Token& next() const {
+      TokenRef next() const {
         CHECK(index_ + 1 < tokens_.size());
-        return *tokens_[index_ + 1];
+        return tokens_[index_ + 1];
+      }
+
+      ETokenType getSimpleTokenType(TokenRef token) const {
+        CHECK(token.isSimple());
+        return token.simpleType();
       }
 
       void reset(ParserState&& state) {
         index_ = state.index;
+        deferredBodies_.resize(state.numDeferredBodies);
       }
 
       bool isSimple(ETokenType type) const {
@@ -200,11 +219,12 @@ namespace compiler {
       }
 
       // TODO: consistent naming (tryAdv vs. tryGet)
-      const TokenSimple* tryAdvSimple(ETokenType type) {
+      bool tryAdvSimple(ETokenType type) {
         if (!isSimple(type)) {
-          return nullptr;
+          return false;
         }
-        return getAdvSimple();
+        adv();
+        return true;
       }
 
       bool nextIsSimple(ETokenType type) const {
@@ -214,19 +234,24 @@ namespace compiler {
         return getSimpleTokenType(next()) == type;
       }
 
-      void complainExpect(string&& expected, const char* func) const {
-        Throw("[{}] expect {}; got: {}",
-              func,
-              move(expected),
-              cur().toStr());
+      // no formatting here: most failures are caught by BT
+      template<typename Expected>
+      void complainExpect(Expected expected, const char* func) {
+        ParseFailure failure(func, expected, index_);
+        furthest_.record(failure);
+        throw failure;
       }
 
-      const TokenSimple*
-        expectSimpleFromFunc(ETokenType type, const char* func) {
-          if (!isSimple(type)) {
-            complainExpect(getSimpleTokenTypeName(type), func);
-          }
-          return getAdvSimple();
+      // the diagnostic for a failure that ended the parse
+      CompilerException parseError(const ParseFailure& failure) const {
+        return CompilerException(furthest_.message(failure, tokens_));
+      }
+
+      void expectSimpleFromFunc(ETokenType type, const char* func) {
+        if (!isSimple(type)) {
+          complainExpect(type, func);
+        }
+        adv();
       }
 
       bool isIdentifier() const {
@@ -237,14 +262,14 @@ namespace compiler {
         if (!isIdentifier()) {
           complainExpect("identifier", func);
         }
-        return getAdv()->toSimpleStr();
+        return getAdv().source();
       }
 
       bool tryGetIdentifier(string& identifier) {
         if (!isIdentifier()) {
           return false;
         }
-        identifier = getAdv()->toSimpleStr();
+        identifier = getAdv().source();
         return true;
       }
 
@@ -256,20 +281,59 @@ namespace compiler {
         if (!isLiteral()) {
           return nullptr;
         }
-        return static_cast<const TokenLiteralBase*>(getAdv());
+        return &getAdv().literal();
       }
 
       const TokenLiteralBase* expectLiteralFromFunc(const char* func) {
         if (!isLiteral()) {
           complainExpect("literal", func);
         }
-        return static_cast<const TokenLiteralBase*>(getAdv());
+        return &getAdv().literal();
       }
 
       bool isEof() const {
         return cur().isEof();
       }
 
+      // Steps over a function body unless bodies are parsed in place; a
+      // deferred one is remembered for the end of the translation unit.
+      // Returns false if the body is to be parsed now.
+      bool skipFunctionBody() {
+        if (option_.bodyMode == BodyMode::Eager || option_.isTrace) {
+          return false;
+        }
+        if (!isSimple(OP_LBRACE)) {
+          BAD_EXPECT("{");
+        }
+        size_t end = matchBrace(tokens_, index_);
+        if (end == string::npos) {
+          BAD_EXPECT("}");
+        }
+        if (option_.bodyMode == BodyMode::Deferred) {
+          TimeReport::count(TimeReport::DeferredBodies);
+          deferredBodies_.push_back(index_);
+        }
+        advanceTo(end + 1);
+        return true;
+      }
+
+      // Lets the token buffer drop what no backtracking can go back to:
+      // the tokens before the oldest BT that may still reset. Deferred
+      // bodies, and the eager parse redone if one fails, need them all.
+      void releaseTokens() {
+        if (option_.bodyMode == BodyMode::Deferred) {
+          return;
+        }
+        size_t begin = index_;
+        for (auto& frame : btFrames_) {
+          if (!frame.second->disableBt) {
+            begin = frame.first;
+            break;
+          }
+        }
+        tokens_.release(begin);
+      }
+
       struct BtControl {
         bool disableBt{ false };
         bool reportError{ false };
@@ -285,11 +349,12 @@ namespace compiler {
         decltype(f(forward<Args>(args)...))
         >::type {
         BtControlGuard guard(this, btControl);
-        Trace trace(option_.isTrace,
-                    name,
-                    bind(&Base::cur, this),
-                    traceDepth_);
-        function<void()> postAction = [&trace]() { trace.success(); };
+        RuleProfile::Call call(profile_, name, index_);
+        Trace trace(option_.isTrace, name, this, traceDepth_);
+        auto postAction = [&trace, &call]() {
+          trace.success();
+          call.success();
+        };
         return postActionCall(postAction, f, forward<Args>(args)...);
       }
 
@@ -325,10 +390,20 @@ namespace compiler {
       auto BT(BtControl& btControl, const char* name, F f, Args&&... args) ->
         decltype(TR(btControl, name, f, forward<Args>(args)...)) {
         using Ret = decltype(TR(btControl, name, f, forward<Args>(args)...));
-        ParserState state{ index_ };
+        ParserState state{ index_, deferredBodies_.size() };
+        BtFrameGuard frame(this, btControl);
         try {
           return TR(btControl, name, f, forward<Args>(args)...);
         }
+        catch (const ParseFailure& failure) {
+          if (btControl.reportError) {
+            cerr << "ERROR: " << parseError(failure).what() << endl;
+          }
+
+          if (btControl.disableBt) {
+            throw;
+          }
+        }
         catch (const CompilerException& e) {
           if (btControl.reportError) {
             cerr << "ERROR: " << e.what() << endl;
@@ -337,10 +412,10 @@ namespace compiler {
           if (btControl.disableBt) {
             throw;
           }
-
-          reset(move(state));
-          return Ret{};
         }
+        TimeReport::count(TimeReport::Backtracks);
+        reset(move(state));
+        return Ret{};
       }
 
       // backtrack - provide stack frame's BtControl
@@ -389,6 +464,17 @@ namespace compiler {
         Base* base_;
       };
 
+      // where each BT that is running started, outermost first
+      struct BtFrameGuard {
+        BtFrameGuard(Base* base, BtControl& btControl) : base_(base) {
+          base_->btFrames_.emplace_back(base_->index_, &btControl);
+        }
+        ~BtFrameGuard() {
+          base_->btFrames_.pop_back();
+        }
+        Base* base_;
+      };
+
       Namespace* curNamespace() const {
         return translationUnit_->curNamespace();
       }
@@ -406,18 +492,25 @@ namespace compiler {
       virtual Namespace* nestedNameSpecifier() = 0;
       virtual UId idExpression() = 0;
 
-      const vector<UToken>& tokens_;
+      TokenBuffer& tokens_;
       size_t index_{ 0 };
 
       ParserOption option_;
       int traceDepth_{ 0 };
+      RuleProfile profile_;
 
       vector<BtControl*> btControlStack_;
+      vector<pair<size_t, BtControl*>> btFrames_;
+
+      FurthestFailure furthest_;
+
+      // the '{' of each function body skipFunctionBody deferred
+      vector<size_t> deferredBodies_;
 
       UTranslationUnit translationUnit_;
     };
 
-    vector<UToken> Base::emptyTokens_;
+    TokenBuffer Base::emptyTokens_;
 
   }
 }
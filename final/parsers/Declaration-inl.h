@@ -52,6 +52,7 @@ struct Declaration : virtual Base {
   void namespaceBody() {
     while (!isSimple(OP_RBRACE)) {
       TR(EX(declaration));
+      releaseTokens();
     }
   }
 
@@ -189,7 +190,7 @@ struct Declaration : virtual Base {
 
     // TODO: abstract this; and we are using the rule for '=' (copy assignment)
     // currently
-    auto expr = literal->assignableTo(make_shared<FundalmentalType>(FT_BOOL));
+    auto expr = literal->assignableTo(FundalmentalType::get(FT_BOOL));
     if (!expr) {
       Throw("{} cannot be contextually converted to bool", *literal);
     }
@@ -0,0 +1,24 @@
+#pragma once
+#include "TokenBuffer.h"
+#include <string>
+
+namespace compiler {
+
+// The index of the '}' closing the '{' at tokens[begin], or npos if the
+// tokens run out first. A function body that parses always ends there, so
+// this is all a parser needs to step over one it defers. The buffer is
+// filled as far as the '}' if it is being filled.
+inline size_t matchBrace(TokenBuffer& tokens, size_t begin)
+{
+  size_t depth = 0;
+  for (size_t i = begin; tokens.ensure(i) && !tokens.isEof(i); ++i) {
+    if (tokens.isSimple(i, OP_LBRACE)) {
+      ++depth;
+    } else if (tokens.isSimple(i, OP_RBRACE) && --depth == 0) {
+      return i;
+    }
+  }
+  return std::string::npos;
+}
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "TokenBuffer.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace compiler {
+
+// A missing expected token. Backtracking drops a great many of these, so it
+// only holds string literals and a token index; the message is formatted
+// once a parse has actually failed. The recognizer returns failures (see
+// PUSH in Parser.cpp); SemanticParser still throws them.
+struct ParseFailure
+{
+  ParseFailure(const char* _func, const char* _expected, size_t _index)
+    : func(_func),
+      expected(_expected),
+      expectedType(),
+      index(_index) { }
+  ParseFailure(const char* _func, ETokenType _expectedType, size_t _index)
+    : func(_func),
+      expected(nullptr),
+      expectedType(_expectedType),
+      index(_index) { }
+
+  std::string expectedName() const {
+    return expected ? expected : getSimpleTokenTypeName(expectedType);
+  }
+  bool sameExpectation(const ParseFailure& rhs) const {
+    return func == rhs.func &&
+           expected == rhs.expected &&
+           (expected || expectedType == rhs.expectedType);
+  }
+  std::string message(const TokenBuffer& tokens) const {
+    return format("[{}] expect {}; got: {}",
+                  func,
+                  expectedName(),
+                  tokens.toStr(index));
+  }
+
+  const char* func;
+  // nullptr if a simple token of expectedType was expected
+  const char* expected;
+  ETokenType expectedType;
+  size_t index;
+};
+
+// What was expected at the furthest token any alternative reached. When a
+// backtracking parse fails, that is usually where the input is wrong.
+class FurthestFailure
+{
+public:
+  void record(const ParseFailure& failure) {
+    if (!reach(failure.index)) {
+      return;
+    }
+    for (auto& f : failures_) {
+      if (f.sameExpectation(failure)) {
+        return;
+      }
+    }
+    failures_.push_back(failure);
+  }
+
+  // the message of the failure that ended the parse, followed by the first
+  // few of the furthest expectations if they lie beyond it
+  std::string message(const ParseFailure& last,
+                      const TokenBuffer& tokens) const {
+    const size_t MaxExpected = 4;
+    std::string msg = last.message(tokens);
+    if (!reached_ || index_ <= last.index) {
+      return msg;
+    }
+    std::vector<std::string> names;
+    for (auto& f : failures_) {
+      std::string name = f.expectedName();
+      if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.push_back(std::move(name));
+      }
+    }
+    std::string expected;
+    for (size_t i = 0; i < names.size() && i < MaxExpected; ++i) {
+      expected += i == 0 ? names[i] : " or " + names[i];
+    }
+    if (names.size() > MaxExpected) {
+      expected += format(" (or {} more)", names.size() - MaxExpected);
+    }
+    return format("{}; furthest: expect {}; got: {}",
+                  msg,
+                  expected,
+                  tokens.toStr(index_));
+  }
+
+  // whether a failure at index or beyond was recorded
+  bool reached(size_t index) const {
+    return reached_ && index_ >= index;
+  }
+
+private:
+  // false if index is short of the furthest failure; forgets those before
+  // it
+  bool reach(size_t index) {
+    if (reached_ && index < index_) {
+      return false;
+    }
+    if (!reached_ || index > index_) {
+      failures_.clear();
+      reached_ = true;
+      index_ = index;
+    }
+    return true;
+  }
+
+  bool reached_ { false };
+  size_t index_ { 0 };
+  std::vector<ParseFailure> failures_;
+};
+
+}
@@ -1,12 +1,66 @@
 #pragma once
 #include "common.h"
+#include <map>
+#include <memory>
+#include <string>
 
 namespace compiler {
 
+class TypeContext;
+
+// What the recognizer remembers about a backtracked rule at a position.
+// Failures are cheap to record; a success needs its own copy of the AST.
+enum class MemoMode {
+  Off,
+  Failures,
+  All
+};
+
+// How recog prints the tree of a successful parse (see ASTWriter)
+enum class ASTFormat {
+  None,
+  Text,
+  Binary
+};
+
+// When function bodies are parsed. A deferred body is only brace-matched
+// where it appears and parsed once the rest of the translation unit is; if
+// anything then fails, the parse is redone eagerly so that the diagnostic
+// is the same. A skipped body is never parsed (nsdecl only).
+enum class BodyMode {
+  Eager,
+  Deferred,
+  Skipped
+};
+
 struct ParserOption
 {
   bool isTrace { false };
   bool isCollapse { true };
+  ASTFormat astFormat { ASTFormat::Text };
+  // packrat memoization in Parser (recog only)
+  MemoMode memoMode { MemoMode::Failures };
+  // overrides of memoMode, by rule name
+  std::map<std::string, MemoMode> ruleMemoModes;
+  // skip backtracked rules whose FIRST set excludes the current token
+  // (recog only)
+  bool isPredictive { true };
+  // try the rules prediction skips too, and stop if any of them gets past
+  // the token it was predicted to fail on (recog only, for testing)
+  bool isPredictionChecked { false };
+  BodyMode bodyMode { BodyMode::Eager };
+  // threads parsing deferred bodies (recog only)
+  unsigned bodyThreads { 1 };
+  // preprocess on a thread of its own, while parsing (Driver only). The
+  // result is the same, but what parsing prints before a preprocessing
+  // error is printed too.
+  bool isPipelined { false };
+  // the fewest tokens a pipelined parse drops at once; only tests want
+  // other than the default
+  size_t minDroppedTokens { 1 << 16 };
+  // the context the translation unit interns its types in, if it is to
+  // share one (nsinit gives every unit that of its Linker)
+  std::shared_ptr<TypeContext> typeContext;
 };
 
 }
@@ -45,20 +45,38 @@ class ParserImp :
 {
 
 public:
-  ParserImp(const vector<UToken>& tokens, const ParserOption& option)
+  ParserImp(TokenBuffer& tokens, const ParserOption& option)
     : Base(tokens, option) {
   }
 
   UTranslationUnit process() {
-    TR(EX(translationUnit));
+    try {
+      TR(EX(translationUnit));
+      parseDeferredBodies();
+    } catch (const ParseFailure& failure) {
+      throw parseError(failure);
+    }
     return move(translationUnit_);
   }
 
 private:
+  // The deferred bodies left by function definitions that stood; any of
+  // them failing means an eager parse may have gone another way, which
+  // SemanticParser::process then finds out.
+  void parseDeferredBodies() {
+    for (size_t begin : deferredBodies_) {
+      advanceTo(begin);
+      TR("functionBody",
+         make_delegate(&SimpleDeclaration::functionBody,
+                       static_cast<SimpleDeclaration*>(this)));
+    }
+  }
+
 
   void translationUnit() {
     while (!isEof()) {
       TR(EXB(declaration));
+      releaseTokens();
     }
     if (!isEof()) {
       BAD_EXPECT("<eof>");
@@ -70,6 +88,16 @@ private:
 
 UTranslationUnit SemanticParser::process()
 {
+  if (option_.bodyMode == BodyMode::Deferred && !option_.isTrace) {
+    try {
+      return SemanticParserImp::ParserImp(tokens_, option_).process();
+    } catch (const CompilerException&) {
+      // parse again to fail the way an eager parse does
+    }
+    ParserOption eager = option_;
+    eager.bodyMode = BodyMode::Eager;
+    return SemanticParserImp::ParserImp(tokens_, eager).process();
+  }
   return SemanticParserImp::ParserImp(tokens_, option_).process();
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 #include "parsers/ParserCommon.h"
-#include "Token.h"
+#include "TokenBuffer.h"
 #include "TranslationUnit.h"
 #include <vector>
 
@@ -10,12 +10,12 @@ namespace compiler
 class SemanticParser
 {
 public:
-  SemanticParser(const std::vector<UToken>& tokens, const ParserOption& option)
+  SemanticParser(TokenBuffer& tokens, const ParserOption& option)
     : tokens_(tokens),
       option_(option) { }
   UTranslationUnit process();
 private:
-  const std::vector<UToken>& tokens_;
+  TokenBuffer& tokens_;
   const ParserOption option_;
 };
 
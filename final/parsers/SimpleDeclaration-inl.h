@@ -87,7 +87,7 @@ struct SimpleDeclaration : virtual Base {
           KW_VOID /*, KW_AUTO */
         })) {
       declSpecifiers.addType(
-        make_shared<FundalmentalType>(getAdvSimple()->type), false);
+        make_shared<FundalmentalType>(getAdvSimple()), false);
     } else {
       auto ns = BT(EXB(nestedNameSpecifier));
       // Note that here we could avoid the lookup by checking whether
@@ -444,7 +444,9 @@ struct SimpleDeclaration : virtual Base {
     translationUnit_->restoreFrame(frame);
 
     // TODO: implement disableBt in functionBody
-    TR(EX(functionBody));
+    if (!skipFunctionBody()) {
+      TR(EX(functionBody));
+    }
     auto id = declarator->getId();
     if (declSpecifiers.isConstExpr()) {
       Throw("constexpr cannot be used for function definition: {}", 
@@ -13,7 +13,7 @@ void printToken(const PPToken& token) {
   if (token.type == PPTokenType::Eof) {
     cout << token.typeName() << endl;
   } else {
-    string encoded = Utf8Encoder::encode(token.data);
+    const string& encoded = token.dataStrU8();
     cout << format("{} {} {}", token.typeName(), encoded.size(), encoded) 
       << endl;
   }
@@ -31,11 +31,7 @@ int main()
 		PPTokenizer tokenizer;
     tokenizer.sendTo(printToken);
 
-		for (char c : input)
-		{
-			unsigned char code_unit = c;
-			tokenizer.process(code_unit);
-		}
+		tokenizer.process(input.data(), input.data() + input.size());
 
 		tokenizer.process(EndOfFile);
 	}
@@ -1,4 +1,5 @@
 #include "common.h"
+#include "TimeReport.h"
 #include "Preprocessor.h"
 #include "BuildEnv.h"
 #include <utility>
@@ -46,6 +47,8 @@ int main(int argc, char** argv)
 		for (int i = 1; i < argc; i++)
 			args.emplace_back(argv[i]);
 
+    TimeReport::parseCommandline(args);
+
 		if (args.size() < 3 || args[0] != "-o")
 			throw logic_error("invalid usage");
 
@@ -69,6 +69,9 @@ public:
         CHECK(false);
     }
   }
+  bool idle() const override { return n_ == 0; }
+  bool insideLineComment() const { return n_ == 2; }
+  bool insideBlockComment() const { return n_ == 3; }
 private:
   // 2 - //
   // 3 - /*
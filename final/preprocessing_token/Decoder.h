@@ -17,6 +17,9 @@ public:
     send_ = send;
   }
   virtual void put(int c) = 0;
+  // true when no characters are buffered, i.e. a plain character would be
+  // sent on unchanged
+  virtual bool idle() const = 0;
   virtual bool turnOffForRawString() const { return true; }
   virtual bool turnOffForQuotedLiteral() const { return false; }
 protected:
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "PreprocessingToken.h"
-#include "Utf8Encoder.h"
 
 namespace compiler {
 
@@ -17,10 +16,8 @@ public:
         checkNewLine(token);
         break;
       case 0:
-        if (token.type == PPTokenType::PPOpOrPunc &&
-            ((token.data.size() == 1 && token.data[0] == '#') ||
-             (token.data.size() == 2 && token.data[0] == '%' &&
-                                        token.data[1] == ':'))) {
+        if (token.is(PPTokenType::PPOpOrPunc, pound_) ||
+            token.is(PPTokenType::PPOpOrPunc, percentColon_)) {
           n_ = 1;
         } else {
           checkNewLine(token);
@@ -28,13 +25,12 @@ public:
         break;
       case 1:
 #if 0
-        std::cout << "data=" << Utf8Encoder::encode(token.data) << '\n';
+        std::cout << "data=" << token.dataStrU8() << '\n';
         std::cout << "match=" 
-                  << (Utf8Encoder::encode(token.data) == "include") << '\n';
+                  << (token.dataStrU8() == "include") << '\n';
         std::cout << "type=" << token.typeName() << '\n';
 #endif
-        if (token.type == PPTokenType::Identifier &&
-            Utf8Encoder::encode(token.data) == "include") {
+        if (token.is(PPTokenType::Identifier, include_)) {
           n_ = 2;
         } else {
           checkNewLine(token);
@@ -63,6 +59,9 @@ private:
     }
   }
   int n_ { 0 };
+  uint32_t pound_ { ppToken::Spellings::intern("#") };
+  uint32_t percentColon_ { ppToken::Spellings::intern("%:") };
+  uint32_t include_ { ppToken::Spellings::intern("include") };
 };
 
 }
@@ -35,6 +35,7 @@ public:
         break;
     }
   }
+  bool idle() const override { return n_ == 0; }
 private:
   int n_ { 0 };
 };
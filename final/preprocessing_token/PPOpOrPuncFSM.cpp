@@ -1,9 +1,7 @@
 #include "PPOpOrPuncFSM.h"
-#include "Utf8Encoder.h"
 #include "common.h"
 #include <string>
 #include <vector>
-#include <unordered_set>
 
 namespace compiler {
 
@@ -25,37 +23,65 @@ const vector<string> Operators =
 };
 
 // See C++ standard 2.13 Operators and punctuators
-const unordered_set<string> Digraph =
+const vector<string> Digraph =
 {
   "new", "delete", "and", "and_eq", "bitand",
   "bitor", "compl", "not", "not_eq", "or",
   "or_eq", "xor", "xor_eq",
 };
 
-PPOpOrPuncFSM::PPOpOrPuncFSM()
+namespace {
+
+const FlatTrie& operators()
 {
-  for (const auto& s : Operators) {
-    trie_.insert(s);
-  }
-  current_ = trie_.root();
+  static const FlatTrie trie(Operators);
+  return trie;
+}
+
+const FlatTrie& digraphs()
+{
+  static const FlatTrie trie(Digraph);
+  return trie;
+}
+
+// the state after "<::", see put(int)
+FlatTrie::State lessColonColon()
+{
+  static const string s = "<::";
+  static const FlatTrie::State state = operators().find(s.begin(), s.end());
+  return state;
+}
+
+}
+
+bool PPOpOrPuncFSM::isOperator(const string& s)
+{
+  FlatTrie::State state = operators().find(s.begin(), s.end());
+  return state != FlatTrie::None && operators().leaf(state) &&
+    state != lessColonColon();
+}
+
+bool PPOpOrPuncFSM::isDigraph(const string& s)
+{
+  return digraphs().contains(s.begin(), s.end());
 }
 
 void PPOpOrPuncFSM::clearInput()
 {
   ch_.clear();
-  current_ = trie_.root();
+  state_ = FlatTrie::Root;
   matched_ = 0;
 }
 
 StateMachine* PPOpOrPuncFSM::put(int c)
 {
-  const TrieNode* next = current_->getChild(c);
-  if (!next) {
+  FlatTrie::State next = operators().next(state_, c);
+  if (next == FlatTrie::None) {
     // cannot match c
-    if (current_ != trie_.root()) {
+    if (state_ != FlatTrie::Root) {
       // we have already matched something
       if (matched_ > 0) {
-        if (Utf8Encoder::encode(ch_) == "<::") {
+        if (state_ == lessColonColon()) {
           if (c == ':' || c == '>') {
             send_(PPToken(PPTokenType::PPOpOrPunc, vector < int > { '<', ':' }));
             matched_ = 2;
@@ -70,14 +96,18 @@ StateMachine* PPOpOrPuncFSM::put(int c)
         }
       }
 
-      vector<int> left(ch_.begin() + matched_, ch_.end());
-      left.push_back(c);
+      int left[MaxOperatorLength + 1];
+      int n = 0;
+      for (size_t i = matched_; i < ch_.size(); ++i) {
+        left[n++] = ch_[i];
+      }
+      left[n++] = c;
       clearInput();
       StateMachine* result { nullptr };
       // one assumption is that x in left until c must match the current
       // state machine
-      for (int x : left) {
-        result = put(x);
+      for (int i = 0; i < n; ++i) {
+        result = put(left[i]);
       }
       return result;
     } else {
@@ -85,9 +115,9 @@ StateMachine* PPOpOrPuncFSM::put(int c)
     }
   } else {
     // do not accept yet in case we can match further
-    current_ = next;
+    state_ = next;
     ch_.push_back(c);
-    if (current_->leaf()) {
+    if (operators().leaf(state_)) {
       matched_ = static_cast<int>(ch_.size());
     }
     return this;
@@ -97,12 +127,10 @@ StateMachine* PPOpOrPuncFSM::put(int c)
 StateMachine* PPOpOrPuncFSM::put(const vector<int>& ch)
 {
   // not allowed to call this while we are in the middle of accepting something
-  CHECK(current_ == trie_.root());
+  CHECK(state_ == FlatTrie::Root);
 
-  string x = Utf8Encoder::encode(ch);
-  // std::cout << "transfered: " << x << std::endl;
-  if (x == "." ||
-      Digraph.find(x) != Digraph.end()) {
+  if ((ch.size() == 1 && ch[0] == '.') ||
+      digraphs().contains(ch.begin(), ch.end())) {
     send_(PPToken(PPTokenType::PPOpOrPunc, ch));
     return this;
   } else {
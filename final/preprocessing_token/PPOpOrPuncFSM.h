@@ -3,6 +3,7 @@
 #include "Trie.h"
 #include "StateMachine.h"
 #include <vector>
+#include <string>
 
 namespace compiler {
 
@@ -11,13 +12,18 @@ namespace ppToken {
 class PPOpOrPuncFSM : public StateMachine
 {
 public:
-  PPOpOrPuncFSM();
   StateMachine* put(int x) override;
   StateMachine* put(const std::vector<int>& ch) override;
+
+  // whether s is exactly one preprocessing-op-or-punc
+  static bool isOperator(const std::string& s);
+  // whether s is an identifier-like preprocessing-op-or-punc
+  static bool isDigraph(const std::string& s);
+  static const size_t MaxOperatorLength = 4;
+  static const size_t MaxDigraphLength = 6;
 private:
   void clearInput();
-  Trie trie_;
-  const TrieNode* current_;
+  FlatTrie::State state_ { FlatTrie::Root };
   std::vector<int> ch_;
   int matched_ { 0 };
 };
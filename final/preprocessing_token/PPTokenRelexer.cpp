@@ -0,0 +1,107 @@
+#include "PPTokenRelexer.h"
+#include "PPOpOrPuncFSM.h"
+#include "Utf8Utils.h"
+#include <string>
+
+namespace compiler {
+
+namespace ppToken {
+
+using namespace std;
+
+namespace {
+
+bool isDigit(int c) {
+  return c >= '0' && c <= '9';
+}
+
+// the ASCII spelling of ch if it is at most maxLength long
+bool toAscii(const vector<int>& ch, size_t maxLength, string* s) {
+  if (ch.size() > maxLength) {
+    return false;
+  }
+  for (int c : ch) {
+    if (c <= 0 || c >= 0x80) {
+      return false;
+    }
+    s->push_back(static_cast<char>(c));
+  }
+  return true;
+}
+
+} // anonymous
+
+bool PPTokenRelexer::isIdentifier(const vector<int>& ch)
+{
+  // see IdentifierFSM
+  if (!Utf8Utils::isIdentifierStart(ch[0])) {
+    return false;
+  }
+  for (size_t i = 1; i < ch.size(); ++i) {
+    if (!Utf8Utils::isIdentifierNonDigit(ch[i]) && !isDigit(ch[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PPTokenRelexer::isPPNumber(const vector<int>& ch)
+{
+  // see PPNumberFSM
+  size_t i = 0;
+  if (ch[i] == '.') {
+    ++i;
+  }
+  if (i == ch.size() || !isDigit(ch[i])) {
+    return false;
+  }
+  for (++i; i < ch.size(); ++i) {
+    int c = ch[i];
+    if (c == '+' || c == '-') {
+      if (ch[i - 1] != 'e' && ch[i - 1] != 'E') {
+        return false;
+      }
+    } else if (c != '.' && 
+               !isDigit(c) && 
+               !Utf8Utils::isIdentifierNonDigit(c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PPTokenRelexer::classify(const vector<int>& ch, PPTokenType* type)
+{
+  if (ch.empty()) {
+    return false;
+  }
+
+  if (isIdentifier(ch)) {
+    // identifier-like operators such as 'and' are transferred to 
+    // PPOpOrPuncFSM by IdentifierFSM
+    string s;
+    *type = toAscii(ch, PPOpOrPuncFSM::MaxDigraphLength, &s) && 
+            PPOpOrPuncFSM::isDigraph(s) ?
+              PPTokenType::PPOpOrPunc :
+              PPTokenType::Identifier;
+    return true;
+  }
+
+  if (isPPNumber(ch)) {
+    *type = PPTokenType::PPNumber;
+    return true;
+  }
+
+  string s;
+  if (toAscii(ch, PPOpOrPuncFSM::MaxOperatorLength, &s) &&
+      PPOpOrPuncFSM::isOperator(s)) {
+    *type = PPTokenType::PPOpOrPunc;
+    return true;
+  }
+
+  return false;
+}
+
+} // ppToken
+
+} // compiler
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "PreprocessingToken.h"
+#include <vector>
+
+namespace compiler {
+
+namespace ppToken {
+
+// Classifies a sequence of code points which is expected to form exactly one
+// pp-token (e.g. the result of the ## operator) without running it through
+// the PPTokenizer decoder and FSM pipeline.
+// Only identifiers, pp-numbers and preprocessing-op-or-puncs are recognized;
+// false is returned for anything else, in which case the caller should fall
+// back to PPTokenizer.
+class PPTokenRelexer
+{
+public:
+  static bool classify(const std::vector<int>& ch, PPTokenType* type);
+private:
+  static bool isIdentifier(const std::vector<int>& ch);
+  static bool isPPNumber(const std::vector<int>& ch);
+};
+
+} // ppToken
+
+} // compiler
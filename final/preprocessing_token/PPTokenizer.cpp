@@ -4,6 +4,9 @@
 
 #include <cctype>
 #include <string>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace compiler {
 
@@ -11,6 +14,50 @@ namespace ppToken {
 
 using namespace std;
 
+namespace {
+
+// characters which may start a multi-character sequence in one of the
+// decoders: UTF-8 continuation, line splice, trigraph, UCN or comment
+bool needsDecoding(unsigned char c) {
+  return c >= 0x80 || c == '\\' || c == '?' || c == '/';
+}
+
+const char* findNeedsDecoding(const char* p, const char* end) {
+#ifdef __SSE2__
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i question = _mm_set1_epi8('?');
+  const __m128i slash = _mm_set1_epi8('/');
+  for (; end - p >= 16; p += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i m = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(x, backslash), _mm_cmpeq_epi8(x, question)),
+      _mm_or_si128(_mm_cmpeq_epi8(x, slash), x));
+    int mask = _mm_movemask_epi8(m);
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#endif
+  while (p != end && !needsDecoding(static_cast<unsigned char>(*p))) {
+    ++p;
+  }
+  return p;
+}
+
+// skips characters which the comment decoder would swallow without a trace
+const char* skipComment(const char* p, const char* end, char close) {
+  while (p != end) {
+    unsigned char c = static_cast<unsigned char>(*p);
+    if (c == close || c >= 0x80 || c == '\\' || c == '?') {
+      break;
+    }
+    ++p;
+  }
+  return p;
+}
+
+}
+
 template<typename T>
 void PPTokenizer::init()
 {
@@ -24,6 +71,7 @@ PPTokenizer::PPTokenizer()
   init<TrigraphDecoder>();
   init<UniversalCharNameDecoder>();
   init<CommentDecoder>();
+  commentDecoder_ = static_cast<CommentDecoder*>(decoders_.back().get());
 
   int n = static_cast<int>(decoders_.size());
   for (int i = 0; i < n - 1; i++) {
@@ -57,6 +105,40 @@ void PPTokenizer::process(int c) {
   decoders_.front()->put(c);
 }
 
+void PPTokenizer::process(const char* begin, const char* end) {
+  for (const char* p = begin; p != end; ) {
+    p = processPlain(p, end);
+    if (p != end) {
+      process(static_cast<unsigned char>(*p++));
+    }
+  }
+}
+
+// Runs of characters that no decoder would touch are handed straight to the
+// tokenizer (or dropped inside a comment); returns where the decoders have
+// to take over again.
+const char* PPTokenizer::processPlain(const char* begin, const char* end) {
+  for (size_t i = 0; i + 1 < decoders_.size(); ++i) {
+    if (!decoders_[i]->idle()) {
+      return begin;
+    }
+  }
+  if (commentDecoder_->insideLineComment()) {
+    return skipComment(begin, end, '\n');
+  }
+  if (commentDecoder_->insideBlockComment()) {
+    return skipComment(begin, end, '*');
+  }
+  if (!commentDecoder_->idle()) {
+    return begin;
+  }
+  const char* p = begin;
+  for (const char* q = findNeedsDecoding(p, end); p != q; ++p) {
+    receivedChar(static_cast<unsigned char>(*p));
+  }
+  return p;
+}
+
 void PPTokenizer::receivedChar(int c) {
   pCh_ = c;
   tokenizer_.put(c);
@@ -69,8 +151,8 @@ bool PPTokenizer::canMergeIntoUserDefined(const PPToken& token) const {
 
 void PPTokenizer::receivedToken(const PPToken& token) {
   if (canMergeIntoUserDefined(token)) {
-    vector<int> data = pToken_.data;
-    data.insert(data.end(), token.data.begin(), token.data.end());
+    vector<int> data = pToken_.data();
+    data.insert(data.end(), token.data().begin(), token.data().end());
     pToken_ = PPToken(pToken_.getUserDefined(), move(data));
   }
   else {
@@ -13,12 +13,16 @@ namespace compiler {
 
 namespace ppToken {
 
+class CommentDecoder;
+
 class PPTokenizer
 {
 public:
   template<typename T> void init();
   PPTokenizer();
   void process(int c);
+  // process the characters (code units) in [begin, end)
+  void process(const char* begin, const char* end);
   void receivedChar(int c);
   bool canMergeIntoUserDefined(const PPToken& token) const;
   void receivedToken(const PPToken& token);
@@ -27,7 +31,10 @@ public:
   }
 
 private:
+  const char* processPlain(const char* begin, const char* end);
+
   std::vector<std::unique_ptr<Decoder>> decoders_;
+  CommentDecoder* commentDecoder_ { nullptr };
   PPTokenizerHelper tokenizer_;
   int pCh_ { -1 };
   PPToken pToken_;
@@ -35,6 +35,9 @@ PPTokenizerHelper::PPTokenizerHelper()
   ppNumber->setTransfer({
     ppOpOrPunc
   });
+  rawStringLiteral_ = rawStringLiteral;
+  characterLiteral_ = characterLiteral;
+  stringLiteral_ = stringLiteral;
 }
 
 template<typename T>
@@ -107,14 +110,13 @@ void PPTokenizerHelper::printChar(int c)
 
 bool PPTokenizerHelper::insideRawString() const
 {
-  auto s = dynamic_cast<RawStringLiteralFSM*>(current_);
-  return s != nullptr && s->inside();
+  return current_ == rawStringLiteral_ && rawStringLiteral_->inside();
 }
 
 bool PPTokenizerHelper::insideQuotedLiteral() const
 {
-  auto s = dynamic_cast<QuotedLiteralFSM*>(current_);
-  return s != nullptr && s->inside();
+  return (current_ == characterLiteral_ && characterLiteral_->inside()) ||
+    (current_ == stringLiteral_ && stringLiteral_->inside());
 }
 
 } // ppToken
@@ -14,6 +14,9 @@ namespace compiler {
 
 namespace ppToken {
 
+class RawStringLiteralFSM;
+class QuotedLiteralFSM;
+
 class PPTokenizerHelper {
 public:
   PPTokenizerHelper();
@@ -30,6 +33,10 @@ private:
   std::vector<std::unique_ptr<StateMachine>> fsms_;
   HeaderNameFSM headerNameFsm_;
   StateMachine* current_ { nullptr };
+  // asked about on every decoded character, so kept instead of casting
+  RawStringLiteralFSM* rawStringLiteral_ { nullptr };
+  QuotedLiteralFSM* characterLiteral_ { nullptr };
+  QuotedLiteralFSM* stringLiteral_ { nullptr };
   std::function<void(const PPToken&)> send_;
   IncludeDetector includeDetector_;
   PPToken pToken_;
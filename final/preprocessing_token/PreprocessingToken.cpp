@@ -1,9 +1,134 @@
 #include "PreprocessingToken.h"
+#include <deque>
+#include <unordered_map>
+#include <utility>
 
 namespace compiler {
 
 namespace ppToken {
 
+using namespace std;
+
+namespace {
+
+struct CodePointsHash {
+  size_t operator()(const vector<int>& v) const {
+    // FNV-1a
+    size_t h = 14695981039346656037ull;
+    for (int c : v) {
+      h = (h ^ static_cast<uint32_t>(c)) * 1099511628211ull;
+    }
+    return h;
+  }
+};
+
+struct SpellingTable {
+  struct Entry {
+    vector<int> data;
+    string u8;
+  };
+  SpellingTable() {
+    get(vector<int>());
+  }
+  uint32_t get(const vector<int>& data) {
+    auto it = ids.find(data);
+    if (it != ids.end()) {
+      return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(entries.size());
+    entries.push_back(Entry{ data, Utf8Encoder::encode(data) });
+    ids.insert(make_pair(data, id));
+    return id;
+  }
+  // deque so that references handed out stay valid
+  deque<Entry> entries;
+  unordered_map<vector<int>, uint32_t, CodePointsHash> ids;
+};
+
+SpellingTable& spellingTable()
+{
+  static SpellingTable table;
+  return table;
+}
+
+struct LocationTable {
+  LocationTable() {
+    files.push_back("");
+    entries.push_back(make_pair(0, -1));
+  }
+  uint32_t get(const string& file, int64_t line) {
+    // consecutive tokens almost always come from the same line
+    if (last != 0 && entries[last].second == line &&
+        files[entries[last].first] == file) {
+      return last;
+    }
+    auto itFile = fileIds.find(file);
+    if (itFile == fileIds.end()) {
+      itFile = fileIds.insert(
+        make_pair(file, static_cast<uint32_t>(files.size()))).first;
+      files.push_back(file);
+    }
+    auto key = make_pair(itFile->second, line);
+    auto it = ids.find(key);
+    if (it == ids.end()) {
+      it = ids.insert(make_pair(key, static_cast<uint32_t>(entries.size())))
+             .first;
+      entries.push_back(key);
+    }
+    last = it->second;
+    return last;
+  }
+  deque<string> files;
+  unordered_map<string, uint32_t> fileIds;
+  deque<pair<uint32_t, int64_t>> entries;
+  map<pair<uint32_t, int64_t>, uint32_t> ids;
+  uint32_t last { 0 };
+};
+
+LocationTable& locationTable()
+{
+  static LocationTable table;
+  return table;
+}
+
+}
+
+uint32_t Spellings::intern(const vector<int>& data)
+{
+  return spellingTable().get(data);
+}
+
+uint32_t Spellings::intern(const string& s)
+{
+  return intern(vector<int>(s.begin(), s.end()));
+}
+
+const vector<int>& Spellings::data(uint32_t id)
+{
+  return spellingTable().entries[id].data;
+}
+
+const string& Spellings::u8(uint32_t id)
+{
+  return spellingTable().entries[id].u8;
+}
+
+uint32_t SourceLocations::intern(const string& file, int64_t line)
+{
+  return locationTable().get(file, line);
+}
+
+const string& SourceLocations::file(uint32_t id)
+{
+  auto& table = locationTable();
+  return table.files[table.entries[id].first];
+}
+
+int64_t SourceLocations::line(uint32_t id)
+{
+  return locationTable().entries[id].second;
+}
+
 const std::vector<std::string> PPTokenTypes::Names {
     { "whitespace-sequence" },
     { "new-line" },
@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace compiler {
 
@@ -15,7 +16,7 @@ struct PPTokenTypes
   static const std::vector<std::string> Names;
 };
 
-enum class PPTokenType {
+enum class PPTokenType : uint8_t {
   WhitespaceSequence,
   NewLine,
   HeaderName,
@@ -33,18 +34,42 @@ enum class PPTokenType {
   Total = Unknown
 };
 
+// Every distinct token spelling is stored once; tokens refer to it by id.
+// Id 0 is the empty spelling.
+class Spellings
+{
+public:
+  static uint32_t intern(const std::vector<int>& data);
+  // s must be ASCII
+  static uint32_t intern(const std::string& s);
+  static const std::vector<int>& data(uint32_t id);
+  static const std::string& u8(uint32_t id);
+};
+
+// (file, line) pairs a token can be annotated with, stored once.
+// Id 0 means no location.
+class SourceLocations
+{
+public:
+  static uint32_t intern(const std::string& file, int64_t line);
+  static const std::string& file(uint32_t id);
+  static int64_t line(uint32_t id);
+};
+
 struct PPToken
 {
   PPToken() { }
-  explicit PPToken(PPTokenType _type, std::vector<int> _data = {}) {
-    type = _type;
-    data.swap(_data);
-  }
+  explicit PPToken(PPTokenType _type, const std::vector<int>& _data = {})
+    : type(_type),
+    spelling(Spellings::intern(_data)) { }
   PPToken(const PPToken& rhs, const std::string& _file, int64_t _line)
     : type(rhs.type),
-    data(rhs.data),
-    file(_file),
-    line(_line) { }
+    spelling(rhs.spelling),
+    location(SourceLocations::intern(_file, _line)) { }
+  PPToken(const PPToken& rhs, uint32_t _location)
+    : type(rhs.type),
+    spelling(rhs.spelling),
+    location(_location) { }
   const std::string& typeName() const {
     return PPTokenTypes::Names[static_cast<int>(type)];
   }
@@ -95,27 +120,37 @@ struct PPToken
     return getUserDefinedFromType(type);
   }
 
-  std::string dataStrU8() const {
-    return Utf8Encoder::encode(data);
+  const std::vector<int>& data() const {
+    return Spellings::data(spelling);
+  }
+
+  const std::string& dataStrU8() const {
+    return Spellings::u8(spelling);
+  }
+
+  bool is(PPTokenType _type, uint32_t _spelling) const {
+    return type == _type && spelling == _spelling;
+  }
+
+  // To track __FILE_ and __LINE__
+  const std::string& file() const {
+    return SourceLocations::file(location);
+  }
+  int64_t line() const {
+    return SourceLocations::line(location);
   }
 
   bool operator==(const PPToken& rhs) const {
     return type == rhs.type &&
-      data == rhs.data;
+      spelling == rhs.spelling;
   }
   bool operator!=(const PPToken& rhs) const {
     return !(*this == rhs);
   }
 
   PPTokenType type { PPTokenType::Unknown };
-  std::vector<int> data;
-
-  // To track __FILE_ and __LINE__
-  // optimize later
-  // e.g. we don't need to store a string, just store a "pointer" should be
-  // sufficient
-  std::string file;
-  int64_t line { -1 };
+  uint32_t spelling { 0 };
+  uint32_t location { 0 };
 };
 
 } // ppToken
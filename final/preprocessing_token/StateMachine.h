@@ -39,7 +39,7 @@ private:
   void sendInteral(const PPToken& token) {
     Throw("send_ not set while receiving {} {}",
           token.typeName(),
-          Utf8Encoder::encode(token.data));
+          Utf8Encoder::encode(token.data()));
   }
 };
 
@@ -11,6 +11,7 @@ namespace ppToken {
 class TrigraphDecoder : public Decoder {
 public:
   void put(int c) override;
+  bool idle() const override { return n_ == 0; }
 private:
   int n_ { 0 };
 };
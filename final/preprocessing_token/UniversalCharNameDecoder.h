@@ -14,6 +14,7 @@ namespace ppToken {
 class UniversalCharNameDecoder : public Decoder {
 public:
   void put(int c) override;
+  bool idle() const override { return n_ == 0; }
 private:
   void checkChar(int64_t c);
 
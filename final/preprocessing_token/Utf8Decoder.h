@@ -16,6 +16,7 @@ class Utf8Decoder : public Decoder
 {
 public:
   void put(int c) override;
+  bool idle() const override { return nchars_ == 0; }
   bool turnOffForRawString() const override { return false; }
 private:
   int getCodePoint() const;
@@ -1,5 +1,7 @@
 #include "BuildEnv.h"
 #include "common.h"
+#include "TimeReport.h"
+#include "RuleProfile.h"
 #include "Preprocessor.h"
 #include "Parser.h"
 #include <vector>
@@ -7,6 +9,8 @@
 #include <stdexcept>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 using namespace compiler;
@@ -14,19 +18,11 @@ using namespace compiler;
 bool DoRecog(BuildEnv env, const string& source, const ParserOption& option)
 {
   try {
-    vector<UToken> tokens;
+    TokenBuffer tokens;
     Preprocessor processor(env, source, [&tokens](const Token& token) {
-      // TODO: consider moving this transformation stage to Parser
-      if (token.isSimple()) {
-        if (static_cast<const TokenSimple&>(token).type == OP_RSHIFT) {
-          tokens.push_back(make_unique<TokenSimple>(">", OP_RSHIFT_1));
-          tokens.push_back(make_unique<TokenSimple>(">", OP_RSHIFT_2));
-          return;
-        }
-      } else if (token.isNewLine()) {
-        return;
-      }
-      tokens.push_back(token.copy());
+      postToken(tokens, token);
+    }, [&tokens](const SpelledToken& token) {
+      postToken(tokens, token);
     });
     processor.process();
 
@@ -38,6 +34,65 @@ bool DoRecog(BuildEnv env, const string& source, const ParserOption& option)
   }
 };
 
+MemoMode getMemoMode(const string& s)
+{
+  if (s == "off") {
+    return MemoMode::Off;
+  } else if (s == "failures") {
+    return MemoMode::Failures;
+  } else if (s == "all") {
+    return MemoMode::All;
+  }
+  throw logic_error("invalid memo mode " + s);
+}
+
+// --memo=<mode> sets the mode of every rule;
+// --memo=<rule>=<mode>,<rule>=<mode>... overrides it for single rules
+void parseMemoSwitches(vector<string>& args, ParserOption& option)
+{
+  const string prefix = "--memo=";
+  for (auto it = args.begin(); it != args.end(); ) {
+    if (it->compare(0, prefix.size(), prefix) != 0) {
+      ++it;
+      continue;
+    }
+    string value = it->substr(prefix.size());
+    if (value.find('=') == string::npos) {
+      option.memoMode = getMemoMode(value);
+    } else {
+      istringstream iss(value);
+      for (string item; getline(iss, item, ','); ) {
+        size_t eq = item.find('=');
+        if (eq == string::npos) {
+          throw logic_error("invalid memo switch " + item);
+        }
+        option.ruleMemoModes[item.substr(0, eq)] = 
+          getMemoMode(item.substr(eq + 1));
+      }
+    }
+    it = args.erase(it);
+  }
+}
+
+// --body-threads=<n> parses deferred bodies on n threads
+void parseBodyThreadsSwitch(vector<string>& args, ParserOption& option)
+{
+  const string prefix = "--body-threads=";
+  for (auto it = args.begin(); it != args.end(); ) {
+    if (it->compare(0, prefix.size(), prefix) != 0) {
+      ++it;
+      continue;
+    }
+    int n = stoi(it->substr(prefix.size()));
+    if (n < 1) {
+      throw logic_error("invalid number of body threads " + *it);
+    }
+    option.bodyMode = BodyMode::Deferred;
+    option.bodyThreads = n;
+    it = args.erase(it);
+  }
+}
+
 int main(int argc, char** argv)
 {
   BuildEnv env;
@@ -48,6 +103,9 @@ int main(int argc, char** argv)
 		for (int i = 1; i < argc; i++)
 			args.emplace_back(argv[i]);
 
+    TimeReport::parseCommandline(args);
+    RuleProfile::parseCommandline(args);
+
     ParserOption option;
     if (hasCommandlineSwitch(args, "--trace")) {
       option.isTrace = true;
@@ -55,6 +113,34 @@ int main(int argc, char** argv)
     if (hasCommandlineSwitch(args, "--expand")) {
       option.isCollapse = false;
     }
+    if (hasCommandlineSwitch(args, "--ast=none")) {
+      option.astFormat = ASTFormat::None;
+    }
+    if (hasCommandlineSwitch(args, "--ast=binary")) {
+      option.astFormat = ASTFormat::Binary;
+    }
+    if (hasCommandlineSwitch(args, "--no-predict")) {
+      option.isPredictive = false;
+    }
+    if (hasCommandlineSwitch(args, "--check-predict")) {
+      option.isPredictionChecked = true;
+    }
+    if (hasCommandlineSwitch(args, "--bodies=deferred")) {
+      option.bodyMode = BodyMode::Deferred;
+    }
+    if (hasCommandlineSwitch(args, "--bodies=parallel")) {
+      option.bodyMode = BodyMode::Deferred;
+      option.bodyThreads = max(2u, thread::hardware_concurrency());
+    }
+    parseBodyThreadsSwitch(args, option);
+    parseMemoSwitches(args, option);
+
+    // --decode-ast <file> prints a tree written with --ast=binary as text
+    if (args.size() == 2 && args[0] == "--decode-ast") {
+      ifstream in(args[1], ios::binary);
+      decodeBinaryAST(in, cout, option.isCollapse);
+      return EXIT_SUCCESS;
+    }
 
 		if (args.size() < 3 || args[0] != "-o")
 			throw logic_error("invalid usage");
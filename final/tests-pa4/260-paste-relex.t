@@ -0,0 +1,14 @@
+#define cat(x,y) x ## y
+#define cat3(x,y,z) x ## y ## z
+
+// classified directly: identifiers, pp-numbers and operators
+cat(foo,bar) cat(_,1) cat(x,À)
+cat(1,2) cat(.,5) cat(1e,+) cat3(0x,1,p) cat(1,.)
+cat(<,<=) cat(-,>) cat(#,#) cat(%:,%:) cat(<,:) cat(an,d) cat(x,or)
+
+// left to the pp-tokenizer: literals and user-defined literals
+cat(L,'a'), cat(u8,"s"), cat(u,"t"), cat(U,'v'), cat("w",_x), cat('y',_z),
+cat(R,"(raw)"), cat(LR,"x(raw)x")
+
+// and pastes that do not form one pp-token, which keep the left operand
+cat(+,-) cat(a,"b") cat(1,'c')
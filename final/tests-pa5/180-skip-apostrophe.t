@@ -0,0 +1,3 @@
+#if 0
+don't
+#endif
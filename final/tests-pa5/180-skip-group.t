@@ -0,0 +1,49 @@
+#define A 1
+
+#if 0
+  nested groups are skipped whole
+# if A
+#  error not here
+# elif A
+#  error not here
+# else
+#  ifdef A
+#   error not here
+#  endif
+# endif
+#else
+one
+#endif
+
+#ifdef B
+/* a directive in a comment ends nothing
+#endif
+*/
+"#endif" '#' '\'' "\"#else"
+R"x(
+#endif
+)x"
+LR"(
+#else
+)"
+// a line comment \
+#endif
+#\
+else
+two
+#endif
+
+#ifndef A
+??=else
+three
+??=endif
+
+#if 0
+%:else
+four
+%: endif
+
+#if 0
+ /* leading comment */ # /* between */ else
+five
+#endif
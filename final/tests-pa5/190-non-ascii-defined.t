@@ -0,0 +1,17 @@
+#define À 1
+#define café 2
+#ifdef À
+ifdef_yes
+#endif
+#ifndef café
+ifndef_wrong
+#endif
+#if defined(À) && defined café && !defined(naïve)
+if_defined_yes
+#endif
+#undef À
+#if defined À
+undef_wrong
+#else
+undef_yes
+#endif
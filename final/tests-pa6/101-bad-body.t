@@ -0,0 +1,8 @@
+int f() { return 1; }
+
+int g()
+{
+	TC1< 1>2 > x1;       // syntax error
+}
+
+int h() { return 2; }
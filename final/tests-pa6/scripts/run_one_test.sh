@@ -1,4 +1,29 @@
 #!/bin/bash
 
 ./$1 -o $3 $2 &> $3.stdout
- 
+status=$?
+
+# The switches in scripts/modes must not change what is printed: the test
+# is run again with each set of them, and a difference from the run above
+# is added to the output, which then does not match the reference. A tree
+# printed in binary is compared as the text it decodes to.
+while read -r mode; do
+  case "$mode" in
+    ""|"#"*) continue ;;
+    "output: "*) outputOnly=1; mode=${mode#output: } ;;
+    *) outputOnly= ;;
+  esac
+  ./$1 $mode -o $3.mode $2 &> $3.mode.stdout
+  modeStatus=$?
+  if [ "$(head -c 4 $3.mode.stdout)" = AST1 ]; then
+    ./$1 --decode-ast $3.mode.stdout &> $3.mode.text
+    mv $3.mode.text $3.mode.stdout
+  fi
+  if [ $modeStatus != $status ] || ! cmp -s $3 $3.mode ||
+     ([ -z "$outputOnly" ] && ! cmp -s $3.stdout $3.mode.stdout); then
+    differences+="differs with $mode"$'\n'
+  fi
+done < $(dirname $0)/modes
+rm -f $3.mode $3.mode.stdout
+echo -n "$differences" >> $3
+exit $status
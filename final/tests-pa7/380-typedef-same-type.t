@@ -0,0 +1,13 @@
+namespace A {
+	typedef int T;
+}
+namespace B {
+	typedef int T;
+	typedef T U;
+}
+namespace C {
+	using namespace A;
+	using namespace B;
+	T x;
+	U y;
+}
@@ -0,0 +1,2396 @@
+namespace N0
+{
+	typedef int T0[1];
+	T0 a[2];
+	char const* p0, * q0[1];
+	int f0(char, double*, T0&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+}
+
+namespace N1
+{
+	typedef int T1[2];
+	T1 a[3];
+	char const* p1, * q1[2];
+	int f1(char, double*, T1&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N0;
+	I::U y1;
+	T0* z1;
+}
+
+namespace N2
+{
+	typedef int T2[3];
+	T2 a[4];
+	char const* p2, * q2[3];
+	int f2(char, double*, T2&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N1;
+	I::U y2;
+	T1* z2;
+}
+
+namespace N3
+{
+	typedef int T3[4];
+	T3 a[5];
+	char const* p3, * q3[4];
+	int f3(char, double*, T3&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N2;
+	I::U y3;
+	T2* z3;
+}
+
+namespace N4
+{
+	typedef int T4[5];
+	T4 a[6];
+	char const* p4, * q4[5];
+	int f4(char, double*, T4&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N3;
+	I::U y4;
+	T3* z4;
+}
+
+namespace N5
+{
+	typedef int T5[6];
+	T5 a[2];
+	char const* p5, * q5[6];
+	int f5(char, double*, T5&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N4;
+	I::U y5;
+	T4* z5;
+}
+
+namespace N6
+{
+	typedef int T6[7];
+	T6 a[3];
+	char const* p6, * q6[7];
+	int f6(char, double*, T6&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N5;
+	I::U y6;
+	T5* z6;
+}
+
+namespace N7
+{
+	typedef int T7[1];
+	T7 a[4];
+	char const* p7, * q7[8];
+	int f7(char, double*, T7&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N6;
+	I::U y7;
+	T6* z7;
+}
+
+namespace N8
+{
+	typedef int T8[2];
+	T8 a[5];
+	char const* p8, * q8[9];
+	int f8(char, double*, T8&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N7;
+	I::U y8;
+	T7* z8;
+}
+
+namespace N9
+{
+	typedef int T9[3];
+	T9 a[6];
+	char const* p9, * q9[10];
+	int f9(char, double*, T9&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N8;
+	I::U y9;
+	T8* z9;
+}
+
+namespace N10
+{
+	typedef int T10[4];
+	T10 a[2];
+	char const* p10, * q10[11];
+	int f10(char, double*, T10&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N9;
+	I::U y10;
+	T9* z10;
+}
+
+namespace N11
+{
+	typedef int T11[5];
+	T11 a[3];
+	char const* p11, * q11[12];
+	int f11(char, double*, T11&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N10;
+	I::U y11;
+	T10* z11;
+}
+
+namespace N12
+{
+	typedef int T12[6];
+	T12 a[4];
+	char const* p12, * q12[13];
+	int f12(char, double*, T12&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N11;
+	I::U y12;
+	T11* z12;
+}
+
+namespace N13
+{
+	typedef int T13[7];
+	T13 a[5];
+	char const* p13, * q13[14];
+	int f13(char, double*, T13&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N12;
+	I::U y13;
+	T12* z13;
+}
+
+namespace N14
+{
+	typedef int T14[1];
+	T14 a[6];
+	char const* p14, * q14[15];
+	int f14(char, double*, T14&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N13;
+	I::U y14;
+	T13* z14;
+}
+
+namespace N15
+{
+	typedef int T15[2];
+	T15 a[2];
+	char const* p15, * q15[16];
+	int f15(char, double*, T15&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N14;
+	I::U y15;
+	T14* z15;
+}
+
+namespace N16
+{
+	typedef int T16[3];
+	T16 a[3];
+	char const* p16, * q16[17];
+	int f16(char, double*, T16&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N15;
+	I::U y16;
+	T15* z16;
+}
+
+namespace N17
+{
+	typedef int T17[4];
+	T17 a[4];
+	char const* p17, * q17[18];
+	int f17(char, double*, T17&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N16;
+	I::U y17;
+	T16* z17;
+}
+
+namespace N18
+{
+	typedef int T18[5];
+	T18 a[5];
+	char const* p18, * q18[19];
+	int f18(char, double*, T18&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N17;
+	I::U y18;
+	T17* z18;
+}
+
+namespace N19
+{
+	typedef int T19[6];
+	T19 a[6];
+	char const* p19, * q19[20];
+	int f19(char, double*, T19&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N18;
+	I::U y19;
+	T18* z19;
+}
+
+namespace N20
+{
+	typedef int T20[7];
+	T20 a[2];
+	char const* p20, * q20[21];
+	int f20(char, double*, T20&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N19;
+	I::U y20;
+	T19* z20;
+}
+
+namespace N21
+{
+	typedef int T21[1];
+	T21 a[3];
+	char const* p21, * q21[22];
+	int f21(char, double*, T21&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N20;
+	I::U y21;
+	T20* z21;
+}
+
+namespace N22
+{
+	typedef int T22[2];
+	T22 a[4];
+	char const* p22, * q22[23];
+	int f22(char, double*, T22&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N21;
+	I::U y22;
+	T21* z22;
+}
+
+namespace N23
+{
+	typedef int T23[3];
+	T23 a[5];
+	char const* p23, * q23[24];
+	int f23(char, double*, T23&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N22;
+	I::U y23;
+	T22* z23;
+}
+
+namespace N24
+{
+	typedef int T24[4];
+	T24 a[6];
+	char const* p24, * q24[25];
+	int f24(char, double*, T24&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N23;
+	I::U y24;
+	T23* z24;
+}
+
+namespace N25
+{
+	typedef int T25[5];
+	T25 a[2];
+	char const* p25, * q25[26];
+	int f25(char, double*, T25&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N24;
+	I::U y25;
+	T24* z25;
+}
+
+namespace N26
+{
+	typedef int T26[6];
+	T26 a[3];
+	char const* p26, * q26[27];
+	int f26(char, double*, T26&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N25;
+	I::U y26;
+	T25* z26;
+}
+
+namespace N27
+{
+	typedef int T27[7];
+	T27 a[4];
+	char const* p27, * q27[28];
+	int f27(char, double*, T27&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N26;
+	I::U y27;
+	T26* z27;
+}
+
+namespace N28
+{
+	typedef int T28[1];
+	T28 a[5];
+	char const* p28, * q28[29];
+	int f28(char, double*, T28&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N27;
+	I::U y28;
+	T27* z28;
+}
+
+namespace N29
+{
+	typedef int T29[2];
+	T29 a[6];
+	char const* p29, * q29[30];
+	int f29(char, double*, T29&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N28;
+	I::U y29;
+	T28* z29;
+}
+
+namespace N30
+{
+	typedef int T30[3];
+	T30 a[2];
+	char const* p30, * q30[31];
+	int f30(char, double*, T30&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N29;
+	I::U y30;
+	T29* z30;
+}
+
+namespace N31
+{
+	typedef int T31[4];
+	T31 a[3];
+	char const* p31, * q31[32];
+	int f31(char, double*, T31&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N30;
+	I::U y31;
+	T30* z31;
+}
+
+namespace N32
+{
+	typedef int T32[5];
+	T32 a[4];
+	char const* p32, * q32[33];
+	int f32(char, double*, T32&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N31;
+	I::U y32;
+	T31* z32;
+}
+
+namespace N33
+{
+	typedef int T33[6];
+	T33 a[5];
+	char const* p33, * q33[34];
+	int f33(char, double*, T33&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N32;
+	I::U y33;
+	T32* z33;
+}
+
+namespace N34
+{
+	typedef int T34[7];
+	T34 a[6];
+	char const* p34, * q34[35];
+	int f34(char, double*, T34&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N33;
+	I::U y34;
+	T33* z34;
+}
+
+namespace N35
+{
+	typedef int T35[1];
+	T35 a[2];
+	char const* p35, * q35[36];
+	int f35(char, double*, T35&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N34;
+	I::U y35;
+	T34* z35;
+}
+
+namespace N36
+{
+	typedef int T36[2];
+	T36 a[3];
+	char const* p36, * q36[37];
+	int f36(char, double*, T36&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N35;
+	I::U y36;
+	T35* z36;
+}
+
+namespace N37
+{
+	typedef int T37[3];
+	T37 a[4];
+	char const* p37, * q37[38];
+	int f37(char, double*, T37&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N36;
+	I::U y37;
+	T36* z37;
+}
+
+namespace N38
+{
+	typedef int T38[4];
+	T38 a[5];
+	char const* p38, * q38[39];
+	int f38(char, double*, T38&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N37;
+	I::U y38;
+	T37* z38;
+}
+
+namespace N39
+{
+	typedef int T39[5];
+	T39 a[6];
+	char const* p39, * q39[40];
+	int f39(char, double*, T39&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N38;
+	I::U y39;
+	T38* z39;
+}
+
+namespace N40
+{
+	typedef int T40[6];
+	T40 a[2];
+	char const* p40, * q40[41];
+	int f40(char, double*, T40&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N39;
+	I::U y40;
+	T39* z40;
+}
+
+namespace N41
+{
+	typedef int T41[7];
+	T41 a[3];
+	char const* p41, * q41[42];
+	int f41(char, double*, T41&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N40;
+	I::U y41;
+	T40* z41;
+}
+
+namespace N42
+{
+	typedef int T42[1];
+	T42 a[4];
+	char const* p42, * q42[43];
+	int f42(char, double*, T42&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N41;
+	I::U y42;
+	T41* z42;
+}
+
+namespace N43
+{
+	typedef int T43[2];
+	T43 a[5];
+	char const* p43, * q43[44];
+	int f43(char, double*, T43&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N42;
+	I::U y43;
+	T42* z43;
+}
+
+namespace N44
+{
+	typedef int T44[3];
+	T44 a[6];
+	char const* p44, * q44[45];
+	int f44(char, double*, T44&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N43;
+	I::U y44;
+	T43* z44;
+}
+
+namespace N45
+{
+	typedef int T45[4];
+	T45 a[2];
+	char const* p45, * q45[46];
+	int f45(char, double*, T45&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N44;
+	I::U y45;
+	T44* z45;
+}
+
+namespace N46
+{
+	typedef int T46[5];
+	T46 a[3];
+	char const* p46, * q46[47];
+	int f46(char, double*, T46&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N45;
+	I::U y46;
+	T45* z46;
+}
+
+namespace N47
+{
+	typedef int T47[6];
+	T47 a[4];
+	char const* p47, * q47[48];
+	int f47(char, double*, T47&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N46;
+	I::U y47;
+	T46* z47;
+}
+
+namespace N48
+{
+	typedef int T48[7];
+	T48 a[5];
+	char const* p48, * q48[49];
+	int f48(char, double*, T48&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N47;
+	I::U y48;
+	T47* z48;
+}
+
+namespace N49
+{
+	typedef int T49[1];
+	T49 a[6];
+	char const* p49, * q49[50];
+	int f49(char, double*, T49&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N48;
+	I::U y49;
+	T48* z49;
+}
+
+namespace N50
+{
+	typedef int T50[2];
+	T50 a[2];
+	char const* p50, * q50[51];
+	int f50(char, double*, T50&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N49;
+	I::U y50;
+	T49* z50;
+}
+
+namespace N51
+{
+	typedef int T51[3];
+	T51 a[3];
+	char const* p51, * q51[52];
+	int f51(char, double*, T51&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N50;
+	I::U y51;
+	T50* z51;
+}
+
+namespace N52
+{
+	typedef int T52[4];
+	T52 a[4];
+	char const* p52, * q52[53];
+	int f52(char, double*, T52&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N51;
+	I::U y52;
+	T51* z52;
+}
+
+namespace N53
+{
+	typedef int T53[5];
+	T53 a[5];
+	char const* p53, * q53[54];
+	int f53(char, double*, T53&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N52;
+	I::U y53;
+	T52* z53;
+}
+
+namespace N54
+{
+	typedef int T54[6];
+	T54 a[6];
+	char const* p54, * q54[55];
+	int f54(char, double*, T54&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N53;
+	I::U y54;
+	T53* z54;
+}
+
+namespace N55
+{
+	typedef int T55[7];
+	T55 a[2];
+	char const* p55, * q55[56];
+	int f55(char, double*, T55&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N54;
+	I::U y55;
+	T54* z55;
+}
+
+namespace N56
+{
+	typedef int T56[1];
+	T56 a[3];
+	char const* p56, * q56[57];
+	int f56(char, double*, T56&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N55;
+	I::U y56;
+	T55* z56;
+}
+
+namespace N57
+{
+	typedef int T57[2];
+	T57 a[4];
+	char const* p57, * q57[58];
+	int f57(char, double*, T57&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N56;
+	I::U y57;
+	T56* z57;
+}
+
+namespace N58
+{
+	typedef int T58[3];
+	T58 a[5];
+	char const* p58, * q58[59];
+	int f58(char, double*, T58&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N57;
+	I::U y58;
+	T57* z58;
+}
+
+namespace N59
+{
+	typedef int T59[4];
+	T59 a[6];
+	char const* p59, * q59[60];
+	int f59(char, double*, T59&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N58;
+	I::U y59;
+	T58* z59;
+}
+
+namespace N60
+{
+	typedef int T60[5];
+	T60 a[2];
+	char const* p60, * q60[61];
+	int f60(char, double*, T60&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N59;
+	I::U y60;
+	T59* z60;
+}
+
+namespace N61
+{
+	typedef int T61[6];
+	T61 a[3];
+	char const* p61, * q61[62];
+	int f61(char, double*, T61&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N60;
+	I::U y61;
+	T60* z61;
+}
+
+namespace N62
+{
+	typedef int T62[7];
+	T62 a[4];
+	char const* p62, * q62[63];
+	int f62(char, double*, T62&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N61;
+	I::U y62;
+	T61* z62;
+}
+
+namespace N63
+{
+	typedef int T63[1];
+	T63 a[5];
+	char const* p63, * q63[64];
+	int f63(char, double*, T63&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N62;
+	I::U y63;
+	T62* z63;
+}
+
+namespace N64
+{
+	typedef int T64[2];
+	T64 a[6];
+	char const* p64, * q64[65];
+	int f64(char, double*, T64&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N63;
+	I::U y64;
+	T63* z64;
+}
+
+namespace N65
+{
+	typedef int T65[3];
+	T65 a[2];
+	char const* p65, * q65[66];
+	int f65(char, double*, T65&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N64;
+	I::U y65;
+	T64* z65;
+}
+
+namespace N66
+{
+	typedef int T66[4];
+	T66 a[3];
+	char const* p66, * q66[67];
+	int f66(char, double*, T66&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N65;
+	I::U y66;
+	T65* z66;
+}
+
+namespace N67
+{
+	typedef int T67[5];
+	T67 a[4];
+	char const* p67, * q67[68];
+	int f67(char, double*, T67&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N66;
+	I::U y67;
+	T66* z67;
+}
+
+namespace N68
+{
+	typedef int T68[6];
+	T68 a[5];
+	char const* p68, * q68[69];
+	int f68(char, double*, T68&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N67;
+	I::U y68;
+	T67* z68;
+}
+
+namespace N69
+{
+	typedef int T69[7];
+	T69 a[6];
+	char const* p69, * q69[70];
+	int f69(char, double*, T69&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N68;
+	I::U y69;
+	T68* z69;
+}
+
+namespace N70
+{
+	typedef int T70[1];
+	T70 a[2];
+	char const* p70, * q70[71];
+	int f70(char, double*, T70&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N69;
+	I::U y70;
+	T69* z70;
+}
+
+namespace N71
+{
+	typedef int T71[2];
+	T71 a[3];
+	char const* p71, * q71[72];
+	int f71(char, double*, T71&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N70;
+	I::U y71;
+	T70* z71;
+}
+
+namespace N72
+{
+	typedef int T72[3];
+	T72 a[4];
+	char const* p72, * q72[73];
+	int f72(char, double*, T72&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N71;
+	I::U y72;
+	T71* z72;
+}
+
+namespace N73
+{
+	typedef int T73[4];
+	T73 a[5];
+	char const* p73, * q73[74];
+	int f73(char, double*, T73&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N72;
+	I::U y73;
+	T72* z73;
+}
+
+namespace N74
+{
+	typedef int T74[5];
+	T74 a[6];
+	char const* p74, * q74[75];
+	int f74(char, double*, T74&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N73;
+	I::U y74;
+	T73* z74;
+}
+
+namespace N75
+{
+	typedef int T75[6];
+	T75 a[2];
+	char const* p75, * q75[76];
+	int f75(char, double*, T75&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N74;
+	I::U y75;
+	T74* z75;
+}
+
+namespace N76
+{
+	typedef int T76[7];
+	T76 a[3];
+	char const* p76, * q76[77];
+	int f76(char, double*, T76&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N75;
+	I::U y76;
+	T75* z76;
+}
+
+namespace N77
+{
+	typedef int T77[1];
+	T77 a[4];
+	char const* p77, * q77[78];
+	int f77(char, double*, T77&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N76;
+	I::U y77;
+	T76* z77;
+}
+
+namespace N78
+{
+	typedef int T78[2];
+	T78 a[5];
+	char const* p78, * q78[79];
+	int f78(char, double*, T78&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N77;
+	I::U y78;
+	T77* z78;
+}
+
+namespace N79
+{
+	typedef int T79[3];
+	T79 a[6];
+	char const* p79, * q79[80];
+	int f79(char, double*, T79&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N78;
+	I::U y79;
+	T78* z79;
+}
+
+namespace N80
+{
+	typedef int T80[4];
+	T80 a[2];
+	char const* p80, * q80[81];
+	int f80(char, double*, T80&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N79;
+	I::U y80;
+	T79* z80;
+}
+
+namespace N81
+{
+	typedef int T81[5];
+	T81 a[3];
+	char const* p81, * q81[82];
+	int f81(char, double*, T81&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N80;
+	I::U y81;
+	T80* z81;
+}
+
+namespace N82
+{
+	typedef int T82[6];
+	T82 a[4];
+	char const* p82, * q82[83];
+	int f82(char, double*, T82&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N81;
+	I::U y82;
+	T81* z82;
+}
+
+namespace N83
+{
+	typedef int T83[7];
+	T83 a[5];
+	char const* p83, * q83[84];
+	int f83(char, double*, T83&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N82;
+	I::U y83;
+	T82* z83;
+}
+
+namespace N84
+{
+	typedef int T84[1];
+	T84 a[6];
+	char const* p84, * q84[85];
+	int f84(char, double*, T84&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N83;
+	I::U y84;
+	T83* z84;
+}
+
+namespace N85
+{
+	typedef int T85[2];
+	T85 a[2];
+	char const* p85, * q85[86];
+	int f85(char, double*, T85&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N84;
+	I::U y85;
+	T84* z85;
+}
+
+namespace N86
+{
+	typedef int T86[3];
+	T86 a[3];
+	char const* p86, * q86[87];
+	int f86(char, double*, T86&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N85;
+	I::U y86;
+	T85* z86;
+}
+
+namespace N87
+{
+	typedef int T87[4];
+	T87 a[4];
+	char const* p87, * q87[88];
+	int f87(char, double*, T87&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N86;
+	I::U y87;
+	T86* z87;
+}
+
+namespace N88
+{
+	typedef int T88[5];
+	T88 a[5];
+	char const* p88, * q88[89];
+	int f88(char, double*, T88&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N87;
+	I::U y88;
+	T87* z88;
+}
+
+namespace N89
+{
+	typedef int T89[6];
+	T89 a[6];
+	char const* p89, * q89[90];
+	int f89(char, double*, T89&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N88;
+	I::U y89;
+	T88* z89;
+}
+
+namespace N90
+{
+	typedef int T90[7];
+	T90 a[2];
+	char const* p90, * q90[91];
+	int f90(char, double*, T90&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N89;
+	I::U y90;
+	T89* z90;
+}
+
+namespace N91
+{
+	typedef int T91[1];
+	T91 a[3];
+	char const* p91, * q91[92];
+	int f91(char, double*, T91&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N90;
+	I::U y91;
+	T90* z91;
+}
+
+namespace N92
+{
+	typedef int T92[2];
+	T92 a[4];
+	char const* p92, * q92[93];
+	int f92(char, double*, T92&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N91;
+	I::U y92;
+	T91* z92;
+}
+
+namespace N93
+{
+	typedef int T93[3];
+	T93 a[5];
+	char const* p93, * q93[94];
+	int f93(char, double*, T93&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N92;
+	I::U y93;
+	T92* z93;
+}
+
+namespace N94
+{
+	typedef int T94[4];
+	T94 a[6];
+	char const* p94, * q94[95];
+	int f94(char, double*, T94&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N93;
+	I::U y94;
+	T93* z94;
+}
+
+namespace N95
+{
+	typedef int T95[5];
+	T95 a[2];
+	char const* p95, * q95[96];
+	int f95(char, double*, T95&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N94;
+	I::U y95;
+	T94* z95;
+}
+
+namespace N96
+{
+	typedef int T96[6];
+	T96 a[3];
+	char const* p96, * q96[97];
+	int f96(char, double*, T96&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N95;
+	I::U y96;
+	T95* z96;
+}
+
+namespace N97
+{
+	typedef int T97[7];
+	T97 a[4];
+	char const* p97, * q97[98];
+	int f97(char, double*, T97&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N96;
+	I::U y97;
+	T96* z97;
+}
+
+namespace N98
+{
+	typedef int T98[1];
+	T98 a[5];
+	char const* p98, * q98[99];
+	int f98(char, double*, T98&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N97;
+	I::U y98;
+	T97* z98;
+}
+
+namespace N99
+{
+	typedef int T99[2];
+	T99 a[6];
+	char const* p99, * q99[100];
+	int f99(char, double*, T99&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N98;
+	I::U y99;
+	T98* z99;
+}
+
+namespace N100
+{
+	typedef int T100[3];
+	T100 a[2];
+	char const* p100, * q100[101];
+	int f100(char, double*, T100&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N99;
+	I::U y100;
+	T99* z100;
+}
+
+namespace N101
+{
+	typedef int T101[4];
+	T101 a[3];
+	char const* p101, * q101[102];
+	int f101(char, double*, T101&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N100;
+	I::U y101;
+	T100* z101;
+}
+
+namespace N102
+{
+	typedef int T102[5];
+	T102 a[4];
+	char const* p102, * q102[103];
+	int f102(char, double*, T102&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N101;
+	I::U y102;
+	T101* z102;
+}
+
+namespace N103
+{
+	typedef int T103[6];
+	T103 a[5];
+	char const* p103, * q103[104];
+	int f103(char, double*, T103&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N102;
+	I::U y103;
+	T102* z103;
+}
+
+namespace N104
+{
+	typedef int T104[7];
+	T104 a[6];
+	char const* p104, * q104[105];
+	int f104(char, double*, T104&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N103;
+	I::U y104;
+	T103* z104;
+}
+
+namespace N105
+{
+	typedef int T105[1];
+	T105 a[2];
+	char const* p105, * q105[106];
+	int f105(char, double*, T105&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N104;
+	I::U y105;
+	T104* z105;
+}
+
+namespace N106
+{
+	typedef int T106[2];
+	T106 a[3];
+	char const* p106, * q106[107];
+	int f106(char, double*, T106&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N105;
+	I::U y106;
+	T105* z106;
+}
+
+namespace N107
+{
+	typedef int T107[3];
+	T107 a[4];
+	char const* p107, * q107[108];
+	int f107(char, double*, T107&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N106;
+	I::U y107;
+	T106* z107;
+}
+
+namespace N108
+{
+	typedef int T108[4];
+	T108 a[5];
+	char const* p108, * q108[109];
+	int f108(char, double*, T108&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N107;
+	I::U y108;
+	T107* z108;
+}
+
+namespace N109
+{
+	typedef int T109[5];
+	T109 a[6];
+	char const* p109, * q109[110];
+	int f109(char, double*, T109&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N108;
+	I::U y109;
+	T108* z109;
+}
+
+namespace N110
+{
+	typedef int T110[6];
+	T110 a[2];
+	char const* p110, * q110[111];
+	int f110(char, double*, T110&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N109;
+	I::U y110;
+	T109* z110;
+}
+
+namespace N111
+{
+	typedef int T111[7];
+	T111 a[3];
+	char const* p111, * q111[112];
+	int f111(char, double*, T111&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N110;
+	I::U y111;
+	T110* z111;
+}
+
+namespace N112
+{
+	typedef int T112[1];
+	T112 a[4];
+	char const* p112, * q112[113];
+	int f112(char, double*, T112&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N111;
+	I::U y112;
+	T111* z112;
+}
+
+namespace N113
+{
+	typedef int T113[2];
+	T113 a[5];
+	char const* p113, * q113[114];
+	int f113(char, double*, T113&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N112;
+	I::U y113;
+	T112* z113;
+}
+
+namespace N114
+{
+	typedef int T114[3];
+	T114 a[6];
+	char const* p114, * q114[115];
+	int f114(char, double*, T114&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N113;
+	I::U y114;
+	T113* z114;
+}
+
+namespace N115
+{
+	typedef int T115[4];
+	T115 a[2];
+	char const* p115, * q115[116];
+	int f115(char, double*, T115&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N114;
+	I::U y115;
+	T114* z115;
+}
+
+namespace N116
+{
+	typedef int T116[5];
+	T116 a[3];
+	char const* p116, * q116[117];
+	int f116(char, double*, T116&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N115;
+	I::U y116;
+	T115* z116;
+}
+
+namespace N117
+{
+	typedef int T117[6];
+	T117 a[4];
+	char const* p117, * q117[118];
+	int f117(char, double*, T117&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N116;
+	I::U y117;
+	T116* z117;
+}
+
+namespace N118
+{
+	typedef int T118[7];
+	T118 a[5];
+	char const* p118, * q118[119];
+	int f118(char, double*, T118&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N117;
+	I::U y118;
+	T117* z118;
+}
+
+namespace N119
+{
+	typedef int T119[1];
+	T119 a[6];
+	char const* p119, * q119[120];
+	int f119(char, double*, T119&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N118;
+	I::U y119;
+	T118* z119;
+}
+
+namespace N120
+{
+	typedef int T120[2];
+	T120 a[2];
+	char const* p120, * q120[121];
+	int f120(char, double*, T120&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N119;
+	I::U y120;
+	T119* z120;
+}
+
+namespace N121
+{
+	typedef int T121[3];
+	T121 a[3];
+	char const* p121, * q121[122];
+	int f121(char, double*, T121&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N120;
+	I::U y121;
+	T120* z121;
+}
+
+namespace N122
+{
+	typedef int T122[4];
+	T122 a[4];
+	char const* p122, * q122[123];
+	int f122(char, double*, T122&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N121;
+	I::U y122;
+	T121* z122;
+}
+
+namespace N123
+{
+	typedef int T123[5];
+	T123 a[5];
+	char const* p123, * q123[124];
+	int f123(char, double*, T123&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N122;
+	I::U y123;
+	T122* z123;
+}
+
+namespace N124
+{
+	typedef int T124[6];
+	T124 a[6];
+	char const* p124, * q124[125];
+	int f124(char, double*, T124&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N123;
+	I::U y124;
+	T123* z124;
+}
+
+namespace N125
+{
+	typedef int T125[7];
+	T125 a[2];
+	char const* p125, * q125[126];
+	int f125(char, double*, T125&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N124;
+	I::U y125;
+	T124* z125;
+}
+
+namespace N126
+{
+	typedef int T126[1];
+	T126 a[3];
+	char const* p126, * q126[127];
+	int f126(char, double*, T126&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N125;
+	I::U y126;
+	T125* z126;
+}
+
+namespace N127
+{
+	typedef int T127[2];
+	T127 a[4];
+	char const* p127, * q127[128];
+	int f127(char, double*, T127&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N126;
+	I::U y127;
+	T126* z127;
+}
+
+namespace N128
+{
+	typedef int T128[3];
+	T128 a[5];
+	char const* p128, * q128[129];
+	int f128(char, double*, T128&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N127;
+	I::U y128;
+	T127* z128;
+}
+
+namespace N129
+{
+	typedef int T129[4];
+	T129 a[6];
+	char const* p129, * q129[130];
+	int f129(char, double*, T129&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N128;
+	I::U y129;
+	T128* z129;
+}
+
+namespace N130
+{
+	typedef int T130[5];
+	T130 a[2];
+	char const* p130, * q130[131];
+	int f130(char, double*, T130&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N129;
+	I::U y130;
+	T129* z130;
+}
+
+namespace N131
+{
+	typedef int T131[6];
+	T131 a[3];
+	char const* p131, * q131[132];
+	int f131(char, double*, T131&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N130;
+	I::U y131;
+	T130* z131;
+}
+
+namespace N132
+{
+	typedef int T132[7];
+	T132 a[4];
+	char const* p132, * q132[133];
+	int f132(char, double*, T132&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N131;
+	I::U y132;
+	T131* z132;
+}
+
+namespace N133
+{
+	typedef int T133[1];
+	T133 a[5];
+	char const* p133, * q133[134];
+	int f133(char, double*, T133&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N132;
+	I::U y133;
+	T132* z133;
+}
+
+namespace N134
+{
+	typedef int T134[2];
+	T134 a[6];
+	char const* p134, * q134[135];
+	int f134(char, double*, T134&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N133;
+	I::U y134;
+	T133* z134;
+}
+
+namespace N135
+{
+	typedef int T135[3];
+	T135 a[2];
+	char const* p135, * q135[136];
+	int f135(char, double*, T135&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N134;
+	I::U y135;
+	T134* z135;
+}
+
+namespace N136
+{
+	typedef int T136[4];
+	T136 a[3];
+	char const* p136, * q136[137];
+	int f136(char, double*, T136&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N135;
+	I::U y136;
+	T135* z136;
+}
+
+namespace N137
+{
+	typedef int T137[5];
+	T137 a[4];
+	char const* p137, * q137[138];
+	int f137(char, double*, T137&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N136;
+	I::U y137;
+	T136* z137;
+}
+
+namespace N138
+{
+	typedef int T138[6];
+	T138 a[5];
+	char const* p138, * q138[139];
+	int f138(char, double*, T138&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N137;
+	I::U y138;
+	T137* z138;
+}
+
+namespace N139
+{
+	typedef int T139[7];
+	T139 a[6];
+	char const* p139, * q139[140];
+	int f139(char, double*, T139&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N138;
+	I::U y139;
+	T138* z139;
+}
+
+namespace N140
+{
+	typedef int T140[1];
+	T140 a[2];
+	char const* p140, * q140[141];
+	int f140(char, double*, T140&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N139;
+	I::U y140;
+	T139* z140;
+}
+
+namespace N141
+{
+	typedef int T141[2];
+	T141 a[3];
+	char const* p141, * q141[142];
+	int f141(char, double*, T141&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N140;
+	I::U y141;
+	T140* z141;
+}
+
+namespace N142
+{
+	typedef int T142[3];
+	T142 a[4];
+	char const* p142, * q142[143];
+	int f142(char, double*, T142&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N141;
+	I::U y142;
+	T141* z142;
+}
+
+namespace N143
+{
+	typedef int T143[4];
+	T143 a[5];
+	char const* p143, * q143[144];
+	int f143(char, double*, T143&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N142;
+	I::U y143;
+	T142* z143;
+}
+
+namespace N144
+{
+	typedef int T144[5];
+	T144 a[6];
+	char const* p144, * q144[145];
+	int f144(char, double*, T144&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N143;
+	I::U y144;
+	T143* z144;
+}
+
+namespace N145
+{
+	typedef int T145[6];
+	T145 a[2];
+	char const* p145, * q145[146];
+	int f145(char, double*, T145&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N144;
+	I::U y145;
+	T144* z145;
+}
+
+namespace N146
+{
+	typedef int T146[7];
+	T146 a[3];
+	char const* p146, * q146[147];
+	int f146(char, double*, T146&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N145;
+	I::U y146;
+	T145* z146;
+}
+
+namespace N147
+{
+	typedef int T147[1];
+	T147 a[4];
+	char const* p147, * q147[148];
+	int f147(char, double*, T147&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N146;
+	I::U y147;
+	T146* z147;
+}
+
+namespace N148
+{
+	typedef int T148[2];
+	T148 a[5];
+	char const* p148, * q148[149];
+	int f148(char, double*, T148&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N147;
+	I::U y148;
+	T147* z148;
+}
+
+namespace N149
+{
+	typedef int T149[3];
+	T149 a[6];
+	char const* p149, * q149[150];
+	int f149(char, double*, T149&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N148;
+	I::U y149;
+	T148* z149;
+}
+
+namespace N150
+{
+	typedef int T150[4];
+	T150 a[2];
+	char const* p150, * q150[151];
+	int f150(char, double*, T150&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N149;
+	I::U y150;
+	T149* z150;
+}
+
+namespace N151
+{
+	typedef int T151[5];
+	T151 a[3];
+	char const* p151, * q151[152];
+	int f151(char, double*, T151&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N150;
+	I::U y151;
+	T150* z151;
+}
+
+namespace N152
+{
+	typedef int T152[6];
+	T152 a[4];
+	char const* p152, * q152[153];
+	int f152(char, double*, T152&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N151;
+	I::U y152;
+	T151* z152;
+}
+
+namespace N153
+{
+	typedef int T153[7];
+	T153 a[5];
+	char const* p153, * q153[154];
+	int f153(char, double*, T153&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N152;
+	I::U y153;
+	T152* z153;
+}
+
+namespace N154
+{
+	typedef int T154[1];
+	T154 a[6];
+	char const* p154, * q154[155];
+	int f154(char, double*, T154&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N153;
+	I::U y154;
+	T153* z154;
+}
+
+namespace N155
+{
+	typedef int T155[2];
+	T155 a[2];
+	char const* p155, * q155[156];
+	int f155(char, double*, T155&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N154;
+	I::U y155;
+	T154* z155;
+}
+
+namespace N156
+{
+	typedef int T156[3];
+	T156 a[3];
+	char const* p156, * q156[157];
+	int f156(char, double*, T156&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N155;
+	I::U y156;
+	T155* z156;
+}
+
+namespace N157
+{
+	typedef int T157[4];
+	T157 a[4];
+	char const* p157, * q157[158];
+	int f157(char, double*, T157&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N156;
+	I::U y157;
+	T156* z157;
+}
+
+namespace N158
+{
+	typedef int T158[5];
+	T158 a[5];
+	char const* p158, * q158[159];
+	int f158(char, double*, T158&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N157;
+	I::U y158;
+	T157* z158;
+}
+
+namespace N159
+{
+	typedef int T159[6];
+	T159 a[6];
+	char const* p159, * q159[160];
+	int f159(char, double*, T159&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N158;
+	I::U y159;
+	T158* z159;
+}
+
+namespace N160
+{
+	typedef int T160[7];
+	T160 a[2];
+	char const* p160, * q160[161];
+	int f160(char, double*, T160&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N159;
+	I::U y160;
+	T159* z160;
+}
+
+namespace N161
+{
+	typedef int T161[1];
+	T161 a[3];
+	char const* p161, * q161[162];
+	int f161(char, double*, T161&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N160;
+	I::U y161;
+	T160* z161;
+}
+
+namespace N162
+{
+	typedef int T162[2];
+	T162 a[4];
+	char const* p162, * q162[163];
+	int f162(char, double*, T162&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N161;
+	I::U y162;
+	T161* z162;
+}
+
+namespace N163
+{
+	typedef int T163[3];
+	T163 a[5];
+	char const* p163, * q163[164];
+	int f163(char, double*, T163&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N162;
+	I::U y163;
+	T162* z163;
+}
+
+namespace N164
+{
+	typedef int T164[4];
+	T164 a[6];
+	char const* p164, * q164[165];
+	int f164(char, double*, T164&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N163;
+	I::U y164;
+	T163* z164;
+}
+
+namespace N165
+{
+	typedef int T165[5];
+	T165 a[2];
+	char const* p165, * q165[166];
+	int f165(char, double*, T165&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N164;
+	I::U y165;
+	T164* z165;
+}
+
+namespace N166
+{
+	typedef int T166[6];
+	T166 a[3];
+	char const* p166, * q166[167];
+	int f166(char, double*, T166&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N165;
+	I::U y166;
+	T165* z166;
+}
+
+namespace N167
+{
+	typedef int T167[7];
+	T167 a[4];
+	char const* p167, * q167[168];
+	int f167(char, double*, T167&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N166;
+	I::U y167;
+	T166* z167;
+}
+
+namespace N168
+{
+	typedef int T168[1];
+	T168 a[5];
+	char const* p168, * q168[169];
+	int f168(char, double*, T168&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N167;
+	I::U y168;
+	T167* z168;
+}
+
+namespace N169
+{
+	typedef int T169[2];
+	T169 a[6];
+	char const* p169, * q169[170];
+	int f169(char, double*, T169&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N168;
+	I::U y169;
+	T168* z169;
+}
+
+namespace N170
+{
+	typedef int T170[3];
+	T170 a[2];
+	char const* p170, * q170[171];
+	int f170(char, double*, T170&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N169;
+	I::U y170;
+	T169* z170;
+}
+
+namespace N171
+{
+	typedef int T171[4];
+	T171 a[3];
+	char const* p171, * q171[172];
+	int f171(char, double*, T171&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N170;
+	I::U y171;
+	T170* z171;
+}
+
+namespace N172
+{
+	typedef int T172[5];
+	T172 a[4];
+	char const* p172, * q172[173];
+	int f172(char, double*, T172&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N171;
+	I::U y172;
+	T171* z172;
+}
+
+namespace N173
+{
+	typedef int T173[6];
+	T173 a[5];
+	char const* p173, * q173[174];
+	int f173(char, double*, T173&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N172;
+	I::U y173;
+	T172* z173;
+}
+
+namespace N174
+{
+	typedef int T174[7];
+	T174 a[6];
+	char const* p174, * q174[175];
+	int f174(char, double*, T174&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N173;
+	I::U y174;
+	T173* z174;
+}
+
+namespace N175
+{
+	typedef int T175[1];
+	T175 a[2];
+	char const* p175, * q175[176];
+	int f175(char, double*, T175&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N174;
+	I::U y175;
+	T174* z175;
+}
+
+namespace N176
+{
+	typedef int T176[2];
+	T176 a[3];
+	char const* p176, * q176[177];
+	int f176(char, double*, T176&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N175;
+	I::U y176;
+	T175* z176;
+}
+
+namespace N177
+{
+	typedef int T177[3];
+	T177 a[4];
+	char const* p177, * q177[178];
+	int f177(char, double*, T177&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N176;
+	I::U y177;
+	T176* z177;
+}
+
+namespace N178
+{
+	typedef int T178[4];
+	T178 a[5];
+	char const* p178, * q178[179];
+	int f178(char, double*, T178&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N177;
+	I::U y178;
+	T177* z178;
+}
+
+namespace N179
+{
+	typedef int T179[5];
+	T179 a[6];
+	char const* p179, * q179[180];
+	int f179(char, double*, T179&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N178;
+	I::U y179;
+	T178* z179;
+}
+
+namespace N180
+{
+	typedef int T180[6];
+	T180 a[2];
+	char const* p180, * q180[181];
+	int f180(char, double*, T180&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N179;
+	I::U y180;
+	T179* z180;
+}
+
+namespace N181
+{
+	typedef int T181[7];
+	T181 a[3];
+	char const* p181, * q181[182];
+	int f181(char, double*, T181&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N180;
+	I::U y181;
+	T180* z181;
+}
+
+namespace N182
+{
+	typedef int T182[1];
+	T182 a[4];
+	char const* p182, * q182[183];
+	int f182(char, double*, T182&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N181;
+	I::U y182;
+	T181* z182;
+}
+
+namespace N183
+{
+	typedef int T183[2];
+	T183 a[5];
+	char const* p183, * q183[184];
+	int f183(char, double*, T183&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N182;
+	I::U y183;
+	T182* z183;
+}
+
+namespace N184
+{
+	typedef int T184[3];
+	T184 a[6];
+	char const* p184, * q184[185];
+	int f184(char, double*, T184&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N183;
+	I::U y184;
+	T183* z184;
+}
+
+namespace N185
+{
+	typedef int T185[4];
+	T185 a[2];
+	char const* p185, * q185[186];
+	int f185(char, double*, T185&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N184;
+	I::U y185;
+	T184* z185;
+}
+
+namespace N186
+{
+	typedef int T186[5];
+	T186 a[3];
+	char const* p186, * q186[187];
+	int f186(char, double*, T186&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N185;
+	I::U y186;
+	T185* z186;
+}
+
+namespace N187
+{
+	typedef int T187[6];
+	T187 a[4];
+	char const* p187, * q187[188];
+	int f187(char, double*, T187&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N186;
+	I::U y187;
+	T186* z187;
+}
+
+namespace N188
+{
+	typedef int T188[7];
+	T188 a[5];
+	char const* p188, * q188[189];
+	int f188(char, double*, T188&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N187;
+	I::U y188;
+	T187* z188;
+}
+
+namespace N189
+{
+	typedef int T189[1];
+	T189 a[6];
+	char const* p189, * q189[190];
+	int f189(char, double*, T189&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N188;
+	I::U y189;
+	T188* z189;
+}
+
+namespace N190
+{
+	typedef int T190[2];
+	T190 a[2];
+	char const* p190, * q190[191];
+	int f190(char, double*, T190&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N189;
+	I::U y190;
+	T189* z190;
+}
+
+namespace N191
+{
+	typedef int T191[3];
+	T191 a[3];
+	char const* p191, * q191[192];
+	int f191(char, double*, T191&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N190;
+	I::U y191;
+	T190* z191;
+}
+
+namespace N192
+{
+	typedef int T192[4];
+	T192 a[4];
+	char const* p192, * q192[193];
+	int f192(char, double*, T192&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N191;
+	I::U y192;
+	T191* z192;
+}
+
+namespace N193
+{
+	typedef int T193[5];
+	T193 a[5];
+	char const* p193, * q193[194];
+	int f193(char, double*, T193&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N192;
+	I::U y193;
+	T192* z193;
+}
+
+namespace N194
+{
+	typedef int T194[6];
+	T194 a[6];
+	char const* p194, * q194[195];
+	int f194(char, double*, T194&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N193;
+	I::U y194;
+	T193* z194;
+}
+
+namespace N195
+{
+	typedef int T195[7];
+	T195 a[2];
+	char const* p195, * q195[196];
+	int f195(char, double*, T195&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N194;
+	I::U y195;
+	T194* z195;
+}
+
+namespace N196
+{
+	typedef int T196[1];
+	T196 a[3];
+	char const* p196, * q196[197];
+	int f196(char, double*, T196&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N195;
+	I::U y196;
+	T195* z196;
+}
+
+namespace N197
+{
+	typedef int T197[2];
+	T197 a[4];
+	char const* p197, * q197[198];
+	int f197(char, double*, T197&);
+	namespace I { typedef unsigned long long int U[3][2]; U x; }
+	using namespace N196;
+	I::U y197;
+	T196* z197;
+}
+
+namespace N198
+{
+	typedef int T198[3];
+	T198 a[5];
+	char const* p198, * q198[199];
+	int f198(char, double*, T198&);
+	namespace I { typedef unsigned long long int U[1][2]; U x; }
+	using namespace N197;
+	I::U y198;
+	T197* z198;
+}
+
+namespace N199
+{
+	typedef int T199[4];
+	T199 a[6];
+	char const* p199, * q199[200];
+	int f199(char, double*, T199&);
+	namespace I { typedef unsigned long long int U[2][2]; U x; }
+	using namespace N198;
+	I::U y199;
+	T198* z199;
+}
@@ -0,0 +1,4 @@
+namespace N { int f(int x) {} }
+int h() {}
+int v;
+namespace N { int g() {} }
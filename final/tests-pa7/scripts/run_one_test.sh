@@ -1,4 +1,6 @@
 #!/bin/bash
 
-./$1 -o $3 $2 &> $3.stdout
+# a test may give switches of its own in a .args file next to it
+args=$(cat ${2%.t}.args 2>/dev/null)
+./$1 $args -o $3 $2 &> $3.stdout
  